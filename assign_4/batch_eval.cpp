@@ -0,0 +1,146 @@
+/**
+ * Evaluate a file of infix expressions, one per line, on several threads.
+ * Usage: ./batch_eval <input file> <output file> [threads]
+ *
+ * The input is memory-mapped and split into one chunk per thread on line boundaries.
+ * Each thread evaluates its lines with its own stacks and formats its results into
+ * its own buffer, so the only shared work is writing the buffers out in input order.
+ * Each output line is "<status> <value>", where status is the EvalStatus code
+ * (0 = ok) and value is 0 for invalid expressions.
+ * Throughput is reported on stderr.
+ */
+#include "eval_expr.h"
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+/**
+ * A range of whole lines of the input and the results for them
+ */
+struct Chunk {
+    const char* begin;
+    const char* end;
+    string out;         // formatted results, one line per input line
+    long lines = 0;
+    long errors = 0;
+};
+
+/**
+ * @brief Evaluate every line of a chunk and format the results into chunk.out
+ * @param chunk the chunk to evaluate
+ */
+void evalChunk(Chunk& chunk) {
+    Stack<float> values;    // stacks are reused for every line of this thread
+    Stack<OperatorEntry> ops;
+    char buffer[48];
+    chunk.out.reserve((chunk.end - chunk.begin) / 2);
+    const char* line = chunk.begin;
+    while (line < chunk.end) {
+        const char* newline = static_cast<const char*>(memchr(line, '\n', chunk.end - line));
+        const char* lineEnd = newline ? newline : chunk.end;
+        int length = lineEnd - line;
+        if (length > 0 && line[length - 1] == '\r') {     // accept CRLF line endings
+            length--;
+        }
+        float result = 0;
+        int errorPos;
+        EvalStatus status = evalInfix(line, length, result, values, ops, errorPos);
+        if (status != EVAL_OK) {
+            result = 0;
+            chunk.errors++;
+        }
+        int n = snprintf(buffer, sizeof(buffer), "%d %g\n", (int)status, result);
+        chunk.out.append(buffer, n);
+        chunk.lines++;
+        line = lineEnd + 1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        cerr << "Usage: " << argv[0] << " <input file> <output file> [threads]" << endl;
+        return 1;
+    }
+    int threads = argc > 3 ? atoi(argv[3]) : (int)thread::hardware_concurrency();
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    int fd = open(argv[1], O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        cerr << "Error: cannot open " << argv[1] << endl;
+        return 1;
+    }
+    size_t size = info.st_size;
+    const char* data = nullptr;
+    if (size > 0) {
+        data = static_cast<const char*>(mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+        if (data == MAP_FAILED) {
+            cerr << "Error: cannot map " << argv[1] << endl;
+            return 1;
+        }
+        madvise(const_cast<char*>(data), size, MADV_SEQUENTIAL);
+    }
+    FILE* output = fopen(argv[2], "w");
+    if (output == nullptr) {
+        cerr << "Error: cannot open " << argv[2] << endl;
+        return 1;
+    }
+    static char writeBuffer[1 << 20];       // results are written through one large stdio buffer
+    setvbuf(output, writeBuffer, _IOFBF, sizeof(writeBuffer));
+
+    auto start = chrono::steady_clock::now();
+    // split the file into one chunk per thread, moving each split point past the next newline
+    vector<Chunk> chunks(threads);
+    const char* end = data + size;
+    const char* split = data;
+    for (int t = 0; t < threads; t++) {
+        chunks[t].begin = split;
+        if (t == threads - 1) {
+            split = end;
+        } else {
+            split = max(split, data + size * (t + 1) / threads);
+            const char* newline = split < end ? static_cast<const char*>(memchr(split, '\n', end - split)) : nullptr;
+            split = newline ? newline + 1 : end;
+        }
+        chunks[t].end = split;
+    }
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread(evalChunk, ref(chunks[t])));
+    }
+    for (thread& w : workers) {
+        w.join();
+    }
+
+    // write the results in input order
+    long lines = 0, errors = 0;
+    for (Chunk& chunk : chunks) {
+        fwrite(chunk.out.data(), 1, chunk.out.size(), output);
+        lines += chunk.lines;
+        errors += chunk.errors;
+    }
+    fclose(output);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    if (data != nullptr) {
+        munmap(const_cast<char*>(data), size);
+    }
+    close(fd);
+    cerr << lines << " lines (" << errors << " invalid) with " << threads << " threads in "
+         << elapsed.count() << " s, " << lines / elapsed.count() / 1e6 << " M lines/s, "
+         << size / elapsed.count() / 1e6 << " MB/s" << endl;
+    return 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * This file benchmarks the expression evaluators.
+ * Usage: ./bench [number of expressions] [file]
+ * If a file is given, the expressions are written to it, one per line, instead of being timed.
+ *
+ */
+#include "eval_expr.h"
+#include "stack.h"
+#include "expr_cache.h"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <stdlib.h>
+using namespace std;
+
+/**
+ * @brief Build a short random infix expression with 3 to 6 single-digit operands.
+ * Operands are 1-9 and there is no - inside parentheses, so there is never a division by zero.
+ */
+string randomExpression() {
+    const char ops[] = {'+', '*', '/', '-'};
+    int operands = 3 + rand() % 4;
+    bool open = false;
+    string expr;
+    for(int i = 0; i < operands; i++) {
+        if(i > 0) {
+            expr += ops[rand() % (open ? 3 : 4)];
+        }
+        if(!open && i < operands - 1 && rand() % 3 == 0) {
+            expr += '(';
+            open = true;
+            expr += (char)('1' + rand() % 9);
+        } else {
+            expr += (char)('1' + rand() % 9);
+            if(open && rand() % 2 == 0) {
+                expr += ')';
+                open = false;
+            }
+        }
+    }
+    if(open) {
+        expr += ')';
+    }
+    return expr;
+}
+
+/**
+ * @brief Time one evaluator over every expression and print the result
+ * @param name label to print
+ * @param exprs the expressions to evaluate
+ * @param eval the evaluator under test
+ */
+void timeEvaluator(const string& name, const vector<string>& exprs, bool (*eval)(string, float&)) {
+    float result = 0, checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for(const string& expr : exprs) {
+        if(eval(expr, result)) {
+            checksum += result;
+        }
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << name << ": " << elapsed.count() << " s, "
+         << exprs.size() / elapsed.count() / 1e6 << " M expr/s (checksum " << checksum << ")" << endl;
+}
+
+// The original path: convert to a postfix string, then evaluate it
+bool evalTwoPhase(string infix_expr, float& result) {
+    return evalPostfixExpr(convertInfixToPostfix(infix_expr), result);
+}
+
+// Apply the operator on top of ops to the top two values
+template <int N>
+void applyTop(Stack<float, N>& values, Stack<char, N>& ops) {
+    char op = 0;
+    float a = 0, b = 0;
+    ops.pop(op);
+    values.pop(b);
+    values.pop(a);
+    values.push(op == '+' ? a + b : op == '-' ? a - b : op == '*' ? a * b : a / b);
+}
+
+/**
+ * @brief Same single-pass algorithm as evalInfixExpr, without error checks, on Stack<T, N>.
+ * N = 0 keeps every stack on the heap like the original Stack<T>, the default N keeps them inline.
+ */
+template <int N>
+bool evalWithStack(string infix_expr, float& result) {
+    int capacity = infix_expr.length() + 1;
+    Stack<float, N> values(capacity);
+    Stack<char, N> ops(capacity);
+    for(char c : infix_expr) {
+        if(isdigit(c)) {
+            values.push(c - '0');
+        } else if(c == '(') {
+            ops.push(c);
+        } else if(c == ')') {
+            while(ops.top() != '(') {
+                applyTop(values, ops);
+            }
+            ops.pop(c);
+        } else {
+            bool high = (c == '*' || c == '/');
+            while(!ops.isEmpty() && ops.top() != '(' && (!high || ops.top() == '*' || ops.top() == '/')) {
+                applyTop(values, ops);
+            }
+            ops.push(c);
+        }
+    }
+    while(!ops.isEmpty()) {
+        applyTop(values, ops);
+    }
+    values.pop(result);
+    return true;
+}
+
+// ExprCache used by evalCached
+ExprCache cache;
+
+// Evaluate through the expression cache
+bool evalCached(string infix_expr, float& result) {
+    int errorPos;
+    return cache.eval(infix_expr, result, errorPos) == EVAL_OK;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    srand(1);
+    vector<string> exprs;
+    for(int i = 0; i < n; i++) {
+        exprs.push_back(randomExpression());
+    }
+    if(argc > 2) {
+        ofstream out(argv[2]);
+        for(const string& expr : exprs) {
+            out << expr << '\n';
+        }
+        return 0;
+    }
+    cout << "Evaluating " << n << " infix expressions" << endl;
+    timeEvaluator("two-phase (postfix string)", exprs, evalTwoPhase);
+    timeEvaluator("single-pass evalInfixExpr  ", exprs, evalInfixExpr);
+    timeEvaluator("single-pass, heap Stack    ", exprs, evalWithStack<0>);
+    timeEvaluator("single-pass, inline Stack  ", exprs, evalWithStack<32>);
+
+    //a rule engine sees the same few thousand, longer, formulas again and again
+    vector<string> formulas;
+    for(int i = 0; i < 2000; i++) {
+        formulas.push_back(randomExpression() + "+" + randomExpression() + "*" + randomExpression() + "-" + randomExpression());
+    }
+    vector<string> repeated;
+    for(int i = 0; i < n; i++) {
+        repeated.push_back(formulas[rand() % formulas.size()]);
+    }
+    cout << "Evaluating " << n << " draws from " << formulas.size() << " formulas" << endl;
+    timeEvaluator("single-pass evalInfixExpr  ", repeated, evalInfixExpr);
+    timeEvaluator("ExprCache                  ", repeated, evalCached);
+    cout << "cache hits " << cache.hits() << ", misses " << cache.misses() << endl;
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * This file benchmarks stacks shared by several threads, as used for a free list of work items:
+ * every thread repeatedly pops an item and pushes it back.
+ * Usage: ./bench_stack [operations per thread]
+ *
+ */
+#include "stack.h"
+#include "concurrent_stack.h"
+#include <iostream>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdlib.h>
+using namespace std;
+
+/**
+ * Stack<T> guarded by one mutex, the setup this benchmark is meant to replace
+ */
+class LockedStack {
+private:
+    Stack<int> stack;
+    mutex lock;
+public:
+    bool push(int val) {
+        lock_guard<mutex> guard(lock);
+        stack.push(val);
+        return true;
+    }
+    bool pop(int& val) {
+        lock_guard<mutex> guard(lock);
+        if (stack.isEmpty()) {
+            return false;
+        }
+        stack.pop(val);
+        return true;
+    }
+};
+
+/**
+ * @brief Run pop/push pairs from several threads at once and print the throughput
+ * @param name label to print
+ * @param stack the shared stack, already holding some items
+ * @param threads number of threads
+ * @param ops number of pop/push pairs per thread
+ */
+template <typename StackType>
+void timeStack(const string& name, StackType& stack, int threads, int ops) {
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&]() {
+            int item;
+            for (int i = 0; i < ops; i++) {
+                if (stack.pop(item)) {
+                    stack.push(item);
+                }
+            }
+        }));
+    }
+    for (thread& w : workers) {
+        w.join();
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << "  " << name << ": " << 2.0 * threads * ops / elapsed.count() / 1e6 << " M ops/s" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    int ops = argc > 1 ? atoi(argv[1]) : 200000;
+    const int items = 1024;
+    cout << "Pop/push pairs, " << ops << " per thread, " << items << " items in the stack" << endl;
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        cout << threads << " threads" << endl;
+        LockedStack locked;
+        TreiberStack<int> treiber;
+        BoundedStack<int> bounded(items);
+        for (int i = 0; i < items; i++) {
+            locked.push(i);
+            treiber.push(i);
+            bounded.push(i);
+        }
+        timeStack("mutex + Stack<int>", locked, threads, ops);
+        timeStack("TreiberStack<int> ", treiber, threads, ops);
+        timeStack("BoundedStack<int> ", bounded, threads, ops);
+    }
+    return 0;
+}
@@ -0,0 +1,301 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file concurrent_stack.h
+// @brief This file defines stacks that can be shared by several threads without a mutex:
+//        TreiberStack<T>, an unbounded lock-free stack, and
+//        BoundedStack<T>, a lock-free stack backed by a fixed array.
+//=======================================================
+//
+// Both stacks keep their elements in slots that are never given back to the
+// system while the stack is alive. A popped slot goes onto a free list and is
+// reused by a later push. The top of each list is a single 64-bit word holding
+// a 32-bit slot index and a 32-bit tag. Every successful compare-and-swap
+// bumps the tag, so a pop that read an old top cannot succeed after that slot
+// was popped and pushed again in the meantime (the ABA problem).
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * One element slot. next links the slot into either the element list or the free list.
+ */
+template <typename T>
+struct StackSlot {
+    // raw storage for the element, constructed on push and destroyed on pop
+    alignas(T) unsigned char storage[sizeof(T)];
+    // index of the slot below this one
+    std::atomic<uint32_t> next;
+
+    T* value() { return reinterpret_cast<T*>(storage); }
+};
+
+/**
+ * Slot storage for TreiberStack. Slots live in chunks of doubling size,
+ * so the stack can grow without ever moving a slot that another thread may be reading.
+ */
+template <typename T>
+class ChunkedSlots {
+private:
+    static const uint32_t FIRST_CHUNK = 64;     // size of chunk 0, chunk k holds FIRST_CHUNK << k slots
+    static const int MAX_CHUNKS = 26;           // FIRST_CHUNK << 26 = 2^32 slot indices
+    std::atomic<StackSlot<T>*> chunks[MAX_CHUNKS];
+    // next index that has never been handed out
+    std::atomic<uint32_t> fresh;
+
+    // chunk that holds slot index i
+    static int chunkOf(uint32_t i) { return 31 - __builtin_clz(i / FIRST_CHUNK + 1); }
+    // index of the first slot in chunk k
+    static uint32_t chunkStart(int k) { return FIRST_CHUNK * ((1u << k) - 1); }
+public:
+    ChunkedSlots(int) : fresh(0) {
+        for (int k = 0; k < MAX_CHUNKS; k++) {
+            chunks[k].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~ChunkedSlots() {
+        for (int k = 0; k < MAX_CHUNKS; k++) {
+            delete[] chunks[k].load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Return the slot at index i. The slot must have been handed out by grow().
+     */
+    StackSlot<T>& at(uint32_t i) {
+        int k = chunkOf(i);
+        return chunks[k].load(std::memory_order_acquire)[i - chunkStart(k)];
+    }
+
+    /**
+     * @brief Hand out a slot that has never been used, allocating its chunk if needed
+     * @param nil value to return when no index is left
+     * @return the index of the new slot
+     */
+    uint32_t grow(uint32_t nil) {
+        uint32_t i = fresh.fetch_add(1, std::memory_order_relaxed);
+        if (i >= nil) {
+            return nil;
+        }
+        int k = chunkOf(i);
+        if (chunks[k].load(std::memory_order_acquire) == nullptr) {
+            // several threads may race to allocate the same chunk, only one of them installs it
+            StackSlot<T>* chunk = new StackSlot<T>[FIRST_CHUNK << k];
+            StackSlot<T>* expected = nullptr;
+            if (!chunks[k].compare_exchange_strong(expected, chunk, std::memory_order_acq_rel)) {
+                delete[] chunk;
+            }
+        }
+        return i;
+    }
+};
+
+/**
+ * Slot storage for BoundedStack: one array allocated up front.
+ */
+template <typename T>
+class FixedSlots {
+private:
+    StackSlot<T>* slots;
+    uint32_t capacity;
+    // next index that has never been handed out
+    std::atomic<uint32_t> fresh;
+public:
+    FixedSlots(int capacity) : slots(new StackSlot<T>[capacity]), capacity(capacity), fresh(0) {}
+
+    ~FixedSlots() { delete[] slots; }
+
+    StackSlot<T>& at(uint32_t i) { return slots[i]; }
+
+    uint32_t grow(uint32_t nil) {
+        // only read-then-increment so fresh never runs past capacity
+        uint32_t i = fresh.load(std::memory_order_relaxed);
+        while (i < capacity) {
+            if (fresh.compare_exchange_weak(i, i + 1, std::memory_order_relaxed)) {
+                return i;
+            }
+        }
+        return nil;
+    }
+};
+
+/**
+ * A lock-free stack of T over slots provided by Slots.
+ * Use it through the TreiberStack and BoundedStack names below.
+ */
+template <typename T, typename Slots>
+class TaggedStack {
+private:
+    static const uint32_t NIL = 0xFFFFFFFFu;    // slot index meaning "no slot"
+
+    Slots slots;
+    // top of the element list and of the free list: tag << 32 | slot index
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> freeHead;
+    // number of elements, only exact when no other thread is pushing or popping
+    alignas(64) std::atomic<int> count;
+
+    static uint32_t indexOf(uint64_t word) { return (uint32_t)word; }
+    static uint64_t retag(uint64_t old, uint32_t index) { return ((old >> 32) + 1) << 32 | index; }
+
+    /**
+     * @brief Link slot i on top of a list
+     * @param list the list head to push onto
+     * @param i index of the slot to push
+     */
+    void pushSlot(std::atomic<uint64_t>& list, uint32_t i) {
+        uint64_t old = list.load(std::memory_order_relaxed);
+        do {
+            slots.at(i).next.store(indexOf(old), std::memory_order_relaxed);
+        } while (!list.compare_exchange_weak(old, retag(old, i), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Unlink the top slot of a list
+     * @param list the list head to pop from
+     * @return the index of the popped slot, or NIL if the list is empty
+     */
+    uint32_t popSlot(std::atomic<uint64_t>& list) {
+        uint64_t old = list.load(std::memory_order_acquire);
+        while (indexOf(old) != NIL) {
+            // the slot may be popped and reused by another thread right now, in which case
+            // next is stale but the tag has changed and the compare-and-swap fails
+            uint32_t next = slots.at(indexOf(old)).next.load(std::memory_order_relaxed);
+            if (list.compare_exchange_weak(old, retag(old, next), std::memory_order_acquire, std::memory_order_acquire)) {
+                return indexOf(old);
+            }
+        }
+        return NIL;
+    }
+
+    /**
+     * @brief Get a slot to store a new element in, reusing a popped one if possible
+     * @return the slot index, or NIL if the stack is full
+     */
+    uint32_t takeSlot() {
+        uint32_t i = popSlot(freeHead);
+        return i != NIL ? i : slots.grow(NIL);
+    }
+
+    // Stacks share their slots with other threads, so they cannot be copied
+    TaggedStack(const TaggedStack&) = delete;
+    TaggedStack& operator = (const TaggedStack&) = delete;
+public:
+    /**
+     * @brief Constructor
+     * @param capacity maximum number of elements for BoundedStack, ignored by TreiberStack
+     */
+    TaggedStack(int capacity = 0) : slots(capacity), head(NIL), freeHead(NIL), count(0) {}
+
+    // Destructor. Must not run while other threads still use the stack.
+    ~TaggedStack() {
+        for (uint32_t i = popSlot(head); i != NIL; i = popSlot(head)) {
+            slots.at(i).value()->~T();
+        }
+    }
+
+    /**
+     * @brief Push a value to the stack
+     * @param val Value to be pushed onto the stack
+     * @return false if the stack is full (BoundedStack only), otherwise true
+     */
+    bool push(const T& val) { return emplace(val); }
+
+    /**
+     * @brief Push a value to the stack by moving it in
+     * @param val Value to be moved onto the stack
+     * @return false if the stack is full (BoundedStack only), otherwise true
+     */
+    bool push(T&& val) { return emplace(std::move(val)); }
+
+    /**
+     * @brief Construct a new element on top of the stack in place
+     * @param args arguments forwarded to the constructor of T
+     * @return false if the stack is full (BoundedStack only), otherwise true
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        uint32_t i = takeSlot();
+        if (i == NIL) {
+            return false;
+        }
+        new (slots.at(i).value()) T(std::forward<Args>(args)...);
+        pushSlot(head, i);
+        count.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief If not empty, removes and gives back the top element
+     * @param val variable to receive the popped element (by ref). The element is moved, not copied.
+     * @return false if the stack was empty, otherwise true
+     */
+    bool pop(T& val) {
+        uint32_t i = popSlot(head);
+        if (i == NIL) {
+            return false;
+        }
+        count.fetch_sub(1, std::memory_order_relaxed);
+        T* element = slots.at(i).value();
+        val = std::move(*element);
+        element->~T();
+        pushSlot(freeHead, i);
+        return true;
+    }
+
+    /**
+     * @brief Copy the top element without removing it. Another thread may pop it right after,
+     * so the value is only a snapshot. Only available for trivially copyable T, since the copy
+     * may overlap a concurrent push into the same slot and is thrown away in that case.
+     * @param val variable to receive the top element (by ref)
+     * @return false if the stack was empty, otherwise true
+     */
+    bool top(T& val) {
+        static_assert(std::is_trivially_copyable<T>::value, "top() needs a trivially copyable T");
+        uint64_t word = head.load(std::memory_order_acquire);
+        while (indexOf(word) != NIL) {
+            unsigned char copy[sizeof(T)];
+            std::memcpy(copy, slots.at(indexOf(word)).storage, sizeof(T));
+            // the copy is good if the top did not change while it was taken
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t again = head.load(std::memory_order_relaxed);
+            if (again == word) {
+                std::memcpy(&val, copy, sizeof(T));
+                return true;
+            }
+            word = again;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Check if the stack is empty
+     * @return true if stack is empty
+     */
+    bool isEmpty() { return indexOf(head.load(std::memory_order_acquire)) == NIL; }
+
+    /**
+     * @brief Returns the number of elements in the stack. Approximate while other threads push or pop.
+     * @return int the number of elements in the stack
+     */
+    int size() { return count.load(std::memory_order_relaxed); }
+};
+
+/**
+ * Unbounded lock-free (Treiber) stack. Grows in chunks and never runs out of room.
+ */
+template <typename T>
+using TreiberStack = TaggedStack<T, ChunkedSlots<T>>;
+
+/**
+ * Lock-free stack over an array of capacity slots allocated up front. push returns false when full.
+ */
+template <typename T>
+using BoundedStack = TaggedStack<T, FixedSlots<T>>;
@@ -0,0 +1,64 @@
+/**
+ * The string/bool versions of the expression functions, which print their errors to cout.
+ * They are thin wrappers over the functions in eval_expr.cpp, which never print.
+ */
+#include <iostream>
+#include "eval_expr.h"
+
+/**
+ * @brief Evaluate a postfix expression, printing an error message if it is invalid
+ * @param postfix_expr The input expression in the postfix format.
+ * @param result gets the evaluated value of the expression (by reference).
+ * @return true if expression is a valid postfix expression and evaluation is done without error, otherwise false.
+ */
+bool evalPostfixExpr(string postfix_expr, float& result) {
+    Stack<float> values;
+    int errorPos;
+    EvalStatus status = evalPostfix(postfix_expr.data(), postfix_expr.length(), result, values, errorPos);
+    if(status == EVAL_INVALID_CHAR){
+        cout << "Error: unknown symbol\n";
+    }
+    else if(status != EVAL_OK){
+        cout << "Error: " << evalStatusMessage(status) << "\n";
+    }
+    return status == EVAL_OK;
+}
+
+/**
+ * @brief Convert an infix expression to an equivalent postfix expression
+ * @param infix_expr The input expression in the infix format.
+ * @return the converted postfix expression. If the input has an invalid character, return "Error: Invalid character "
+ * followed by that character. If the input infix expression is invalid in another way, return an empty string "";
+ */
+string convertInfixToPostfix(string infix_expr) {
+    string postfix;
+    int errorPos;
+    EvalStatus status = convertInfix(infix_expr.data(), infix_expr.length(), postfix, errorPos);
+    if(status == EVAL_INVALID_CHAR){
+        return string("Error: Invalid character ") + infix_expr[errorPos];
+    }
+    if(status != EVAL_OK){
+        return "";
+    }
+    return postfix;
+}
+
+/**
+ * @brief Evaluate an infix expression in a single pass, printing an error message if it is invalid
+ * @param infix_expr The input expression in the infix format.
+ * @param result gets the evaluated value of the expression (by reference).
+ * @return true if expression is valid and evaluation is done without error, otherwise false.
+ */
+bool evalInfixExpr(string infix_expr, float& result) {
+    Stack<float> values;
+    Stack<OperatorEntry> ops;
+    int errorPos;
+    EvalStatus status = evalInfix(infix_expr.data(), infix_expr.length(), result, values, ops, errorPos);
+    if(status == EVAL_INVALID_CHAR){
+        cout << "Error: Invalid character " << infix_expr[errorPos] << endl;
+    }
+    else if(status != EVAL_OK){
+        cout << "Error: " << evalStatusMessage(status) << "\n";
+    }
+    return status == EVAL_OK;
+}
@@ -1,141 +1,604 @@
 /**
  * Implementation of the functions to evaluate arithmetic expressions
  * The implementation should use the Stack data structure
+ * Nothing in this file prints; errors are returned as an EvalStatus and an offset into the input.
+ * The printing string/bool functions are in eval_console.cpp.
  */
 //You should always comments to each function to describe its PURPOSE and PARAMETERS
 #include "stack.h"
 #include "eval_expr.h"
+#include <algorithm>
+#include <math.h>
+#include <string.h>
 
 /**
- * @brief Evaluate a postfix expression
- * @param postfix_expr The input expression in the postfix format.
- * @param result gets the evaluated value of the expression (by reference).
- * @return true if expression is a valid postfix expression and evaluation is done without error, otherwise false.
- */
-bool evalPostfixExpr(string postfix_expr, float& result) {
-    Stack<float> stack = Stack<float>(postfix_expr.length());       //create a Stack of type float and length of the input string
-    float op1, op2;                                                 //declare 2 float variables to be used in evaluation
-    for(char c : postfix_expr){                                     //iterate through each individual character of the input string
-        if(isdigit(c)){                                             //returns true if char c is 0-9, false otherwise
-            string s(1,c);                                          //create a new string that contains only char c
-            stack.push(stof(s));                                    //push float equivalent of string s to top of stack
-        }
-        else{                                                       
-            if(stack.size() < 2){                                   //less than 2 operands, and an operator is called
-                cout << "Error: invalid expression!\n";             //error is called and return false
-                return false;                                       
-            }
-            else{                                                   //>=2 operands, and an operator is called
-                if(c == '*'){                                       //if multiplication
-                    stack.pop(op2);                                 //pop top 2 elements from stack and push the result of multiplying them
-                    stack.pop(op1);
-                    stack.push(op1 * op2);
-                }
-                else if(c == '+'){                                  //if addition
-                    stack.pop(op2);                                 //pop top 2 elements from stack and push the result of adding them
-                    stack.pop(op1);
-                    stack.push(op1 + op2);
-                }
-                else if(c == '-'){                                  //if subtraction
-                    stack.pop(op2);                                 //pop top 2 elements from stack and push the result of subtracting them
-                    stack.pop(op1);
-                    stack.push(op1 - op2);
-                }
-                else if(c == '/'){                                  //if division
-                    stack.pop(op2);                                 //pop the denominator from stack
-                    if(op2 == 0){                                   //if zero, error is called and return false
-                        cout << "Error: division by zero\n";
-                        return false;
-                    }
-                    stack.pop(op1);                                 //pop the numerator from stack and push the result of dividing them
-                    stack.push(op1 / op2);
-                }
-                else{                                               //if it is not an operator symbol
-                    cout << "Error: unknown symbol\n";              //error is called and return false
-                    return false;
-                }
+ * One entry of the operator table. Every operator and function the infix parser knows is listed here;
+ * the parser and the evaluators only look operators up through this table.
+ */
+struct OperatorInfo {
+    char code;              // code used on the operator stack and in PostfixInstr
+    const char* symbol;     // spelling in infix expressions
+    int precedence;         // higher binds tighter. 0 for functions, which are applied at their ')'
+    bool rightAssoc;        // true if a op b op c groups as a op (b op c)
+    int arity;              // number of operands
+    bool function;          // true if written as symbol(args)
+};
+
+// Two-character symbols come before their one-character prefixes, so the longest match wins.
+// The unary minus (code '~') is matched in place of binary minus wherever an operand is expected.
+static const OperatorInfo operatorTable[] = {
+    {'l', "<=",  2, false, 2, false},
+    {'g', ">=",  2, false, 2, false},
+    {'=', "==",  1, false, 2, false},
+    {'!', "!=",  1, false, 2, false},
+    {'<', "<",   2, false, 2, false},
+    {'>', ">",   2, false, 2, false},
+    {'+', "+",   3, false, 2, false},
+    {'-', "-",   3, false, 2, false},
+    {'*', "*",   4, false, 2, false},
+    {'/', "/",   4, false, 2, false},
+    {'~', "-",   5, true,  1, false},
+    {'^', "^",   6, true,  2, false},
+    {'m', "min", 0, false, 2, true},
+    {'M', "max", 0, false, 2, true},
+    {'a', "abs", 0, false, 1, true},
+};
+static const int OPERATOR_COUNT = sizeof(operatorTable) / sizeof(operatorTable[0]);
+
+/**
+ * Lookup tables over operatorTable, built once when the program starts
+ */
+struct OperatorIndex {
+    const OperatorInfo* byCode[128];            // operator by its code
+    const OperatorInfo* binaryByFirst[128][2];  // binary operators by the first character of their symbol, longest first
+
+    OperatorIndex() {
+        for(int c = 0; c < 128; c++){
+            byCode[c] = nullptr;
+            binaryByFirst[c][0] = binaryByFirst[c][1] = nullptr;
+        }
+        for(int i = 0; i < OPERATOR_COUNT; i++){
+            const OperatorInfo& info = operatorTable[i];
+            byCode[(int)info.code] = &info;
+            if(!info.function && info.arity == 2){
+                const OperatorInfo** slot = binaryByFirst[(int)info.symbol[0]];
+                slot[slot[0] == nullptr ? 0 : 1] = &info;
             }
         }
     }
-    stack.pop(result);                                              //pop the top and only remaining element from the stack and assign it to result
-    return true;                                                    //and return true
+};
+static const OperatorIndex operatorIndex;
+
+/**
+ * @brief Look up an operator by its code
+ * @param code the code of the operator
+ * @return the table entry, or nullptr if code is not an operator (for example '(')
+ */
+static const OperatorInfo* operatorByCode(char code) {
+    return (code >= 0) ? operatorIndex.byCode[(int)code] : nullptr;
 }
 
 /**
- * @brief Convert an infix expression to an equivalent postfix expression
- * @param infix_expr The input expression in the infix format.
- * @return the converted postfix expression. If the input infix expression is invalid, return an empty string "";
- */
-string convertInfixToPostfix(string infix_expr) {
-    string postfix;                                                 //string to compile postfix output
-    Stack<char> stack;                                              //stack of type char to use in evaluation
-    char top;                                                       //char to assign when popping from stack
-    for(char c : infix_expr){                                       //iterate through each char in the input string
-        if(isdigit(c)){                                             //returns true if char c is 0-9, false otherwise
-            postfix += c;                                           //append char c to end of postfix string
-        }
-        else{                                                       //char c is not a digit
-            if(stack.isEmpty()){                                    //special case when stack is empty
-                //if a legitimate operator is called when the stack is empty, push it to the stack
-                if(c == '+' || c == '-' || c == '*' || c == '/' || c == '('){
-                    stack.push(c);
+ * @brief Find the binary operator spelled at expr[i]
+ * @param expr the expression
+ * @param i offset to look at
+ * @param length number of characters in the expression
+ * @return the table entry, or nullptr if no binary operator starts at i
+ */
+static const OperatorInfo* matchBinaryOperator(const char* expr, int i, int length) {
+    if(expr[i] < 0){
+        return nullptr;
+    }
+    for(const OperatorInfo* info : operatorIndex.binaryByFirst[(int)expr[i]]){
+        if(info == nullptr){
+            break;
+        }
+        int n = 1;
+        while(info->symbol[n] != '\0' && i + n < length && expr[i + n] == info->symbol[n]){
+            n++;
+        }
+        if(info->symbol[n] == '\0'){
+            return info;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Find the function with a given name
+ * @param name pointer to the first character of the name
+ * @param length number of characters in the name
+ * @return the table entry, or nullptr if there is no such function
+ */
+static const OperatorInfo* matchFunction(const char* name, int length) {
+    for(int k = 0; k < OPERATOR_COUNT; k++){
+        const OperatorInfo& info = operatorTable[k];
+        if(info.function && strncmp(info.symbol, name, length) == 0 && info.symbol[length] == '\0'){
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Check if a character is one of the original operators + - * /, the ones postfix strings use
+ */
+static bool isBasicOperator(char c) {
+    return c == '+' || c == '-' || c == '*' || c == '/';
+}
+
+/**
+ * @brief Pop the operands of an operator off the value stack, apply the operator to them and push the result
+ * @param values the value stack holding the operands
+ * @param op the code of the operator to apply
+ * @return EVAL_OK, or the reason the operator could not be applied
+ */
+static EvalStatus applyOperator(Stack<float>& values, char op) {
+    float op1 = 0, op2 = 0;
+    const OperatorInfo* info = operatorByCode(op);
+    if(values.size() < info->arity){                                //not enough operands
+        return EVAL_INVALID_EXPR;
+    }
+    values.pop(op2);                                                //right operand is on top
+    if(info->arity == 2){
+        values.pop(op1);
+    }
+    switch(op){
+    case '+': values.push(op1 + op2); break;
+    case '-': values.push(op1 - op2); break;
+    case '*': values.push(op1 * op2); break;
+    case '/':
+        if(op2 == 0){
+            return EVAL_DIV_BY_ZERO;
+        }
+        values.push(op1 / op2);
+        break;
+    case '^': values.push(powf(op1, op2)); break;
+    case '~': values.push(-op2); break;
+    case '<': values.push(op1 < op2); break;
+    case '>': values.push(op1 > op2); break;
+    case 'l': values.push(op1 <= op2); break;
+    case 'g': values.push(op1 >= op2); break;
+    case '=': values.push(op1 == op2); break;
+    case '!': values.push(op1 != op2); break;
+    case 'm': values.push(min(op1, op2)); break;
+    case 'M': values.push(max(op1, op2)); break;
+    case 'a': values.push(fabsf(op2)); break;
+    }
+    return EVAL_OK;
+}
+
+/**
+ * Output of the shunting-yard pass that evaluates each operator right away
+ */
+struct ValueSink {
+    Stack<float>& values;
+    const Variables* vars;
+    int& errorPos;
+
+    EvalStatus operand(float value, int, int) {
+        values.push(value);
+        return EVAL_OK;
+    }
+    EvalStatus variable(const char* name, int length, int) {
+        if(vars == nullptr){
+            return EVAL_UNKNOWN_VARIABLE;
+        }
+        Variables::const_iterator found = vars->find(string(name, length));
+        if(found == vars->end()){
+            return EVAL_UNKNOWN_VARIABLE;
+        }
+        values.push(found->second);
+        return EVAL_OK;
+    }
+    EvalStatus apply(char op, int pos) {
+        EvalStatus status = applyOperator(values, op);
+        if(status != EVAL_OK){                                      //report the operator, as runPostfix does
+            errorPos = pos;
+        }
+        return status;
+    }
+    EvalStatus finish() { return values.size() == 1 ? EVAL_OK : EVAL_INVALID_EXPR; }
+};
+
+/**
+ * Output of the shunting-yard pass that records a postfix program instead of evaluating.
+ * It tracks the value stack depth so a program that would run out of operands is rejected here.
+ */
+struct ProgramSink {
+    PostfixProgram& program;
+    int depth;
+
+    EvalStatus operand(float value, int pos, int) {
+        PostfixInstr instr = {0, 0, value, pos};
+        program.code.push_back(instr);
+        depth++;
+        program.maxDepth = max(program.maxDepth, depth);
+        return EVAL_OK;
+    }
+    EvalStatus variable(const char* name, int length, int pos) {
+        //variables are numbered in order of first use, and read from that slot at run time
+        int slot = 0;
+        while(slot < (int)program.variables.size() && program.variables[slot].compare(0, string::npos, name, length) != 0){
+            slot++;
+        }
+        if(slot == (int)program.variables.size()){
+            program.variables.push_back(string(name, length));
+        }
+        PostfixInstr instr = {'v', slot, 0, pos};
+        program.code.push_back(instr);
+        depth++;
+        program.maxDepth = max(program.maxDepth, depth);
+        return EVAL_OK;
+    }
+    EvalStatus apply(char op, int pos) {
+        int arity = operatorByCode(op)->arity;
+        if(depth < arity){                                          //not enough operands
+            return EVAL_INVALID_EXPR;
+        }
+        PostfixInstr instr = {op, 0, 0, pos};
+        program.code.push_back(instr);
+        depth -= arity - 1;
+        return EVAL_OK;
+    }
+    EvalStatus finish() { return depth == 1 ? EVAL_OK : EVAL_INVALID_EXPR; }
+};
+
+/**
+ * Output of the shunting-yard pass that writes a postfix string, checking operands the same way as ProgramSink.
+ * Postfix strings only have single digits and + - * /, so anything else is rejected as EVAL_INVALID_EXPR.
+ */
+struct PostfixStringSink {
+    const char* expr;
+    string& postfix;
+    int depth;
+
+    EvalStatus operand(float, int pos, int length) {
+        if(length != 1){                                            //operands are single digits
+            return EVAL_INVALID_EXPR;
+        }
+        postfix += expr[pos];
+        depth++;
+        return EVAL_OK;
+    }
+    EvalStatus variable(const char*, int, int) { return EVAL_INVALID_EXPR; }
+    EvalStatus apply(char op, int) {
+        if(depth < 2 || !isBasicOperator(op)){                      //an operator needs 2 operands
+            return EVAL_INVALID_EXPR;
+        }
+        postfix += op;
+        depth--;
+        return EVAL_OK;
+    }
+    EvalStatus finish() { return depth == 1 ? EVAL_OK : EVAL_INVALID_EXPR; }
+};
+
+/**
+ * @brief Read a number starting at expr[i]: digits, optionally followed by '.' and more digits
+ * @param expr the expression
+ * @param i offset of the first digit, moved past the number (by reference)
+ * @param length number of characters in the expression
+ * @return the value of the number
+ */
+static float readNumber(const char* expr, int& i, int length) {
+    double value = 0;
+    while(i < length && isdigit(expr[i])){
+        value = value * 10 + (expr[i] - '0');
+        i++;
+    }
+    if(i + 1 < length && expr[i] == '.' && isdigit(expr[i + 1])){
+        double scale = 1;
+        i++;
+        while(i < length && isdigit(expr[i])){
+            scale /= 10;
+            value += (expr[i] - '0') * scale;
+            i++;
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief Check if a character can start a variable or function name
+ */
+static bool isNameStart(char c) {
+    return isalpha((unsigned char)c) || c == '_';
+}
+
+/**
+ * @brief The shunting-yard pass shared by evaluation and compilation. Operands and operators are
+ * handed to the sink in postfix order, as soon as they would have been appended to a postfix string.
+ * Precedence, associativity and arity all come from operatorTable.
+ * @param expr pointer to the first character of the expression
+ * @param length number of characters in the expression
+ * @param ops operator stack to work in, must be empty. Each entry keeps its source offset for error positions.
+ * @param sink receives operand(value, pos, length), variable(name, length, pos) and apply(code, pos) calls in postfix order
+ * @param errorPos gets the offset of the character where an error was found, or length if it was found at the end.
+ * @return EVAL_OK if the expression is valid, otherwise the kind of error.
+ */
+template <typename Sink>
+static EvalStatus shuntingYard(const char* expr, int length, Stack<OperatorEntry>& ops, Sink& sink, int& errorPos) {
+    bool expectOperand = true;                                      //false right after an operand or )
+    EvalStatus status;
+    OperatorEntry top;
+    int i = 0;
+    while(i < length){                                              //iterate through each token in the input
+        char c = expr[i];
+        errorPos = i;
+        if(isInfixSpace(c)){                                        //whitespace separates tokens
+            i++;
+        }
+        else if(isdigit(c)){                                        //numbers go straight to the output
+            if(!expectOperand){
+                return EVAL_INVALID_EXPR;
+            }
+            int start = i;
+            float value = readNumber(expr, i, length);
+            if((status = sink.operand(value, start, i - start)) != EVAL_OK){
+                return status;
+            }
+            expectOperand = false;
+        }
+        else if(isNameStart(c)){                                    //a function call or a variable
+            if(!expectOperand){
+                return EVAL_INVALID_EXPR;
+            }
+            int start = i;
+            while(i < length && (isNameStart(expr[i]) || isdigit(expr[i]))){
+                i++;
+            }
+            const OperatorInfo* function = matchFunction(expr + start, i - start);
+            if(function != nullptr){                                //function waits on the operator stack, below its (
+                int next = i;
+                while(next < length && isInfixSpace(expr[next])){
+                    next++;
                 }
-                //otherwise, error is called, and the invalid character is returned from the function
-                else{
-                    string error = "Error: Invalid character ";
-                    error += c;
-                    return error;
+                if(next == length || expr[next] != '('){
+                    return EVAL_INVALID_EXPR;
                 }
+                ops.push({function->code, start, 0});
             }
-            else{                                                   //stack is not empty
-                if(c == '('){                                       //if c is a (, push to top of stack
-                    stack.push(c);
+            else{
+                if((status = sink.variable(expr + start, i - start, start)) != EVAL_OK){
+                    return status;
                 }
-                else if(c == ')'){                                  //if c is a ), pop all elements from the stack
-                    while(stack.top() != '('){                      //until ( is encountered, and append them to 
-                        stack.pop(top);                             //the postfix string
-                        postfix += top;
+                expectOperand = false;
+            }
+        }
+        else if(c == '('){                                          //( waits on the operator stack
+            if(!expectOperand){
+                return EVAL_INVALID_EXPR;
+            }
+            ops.push({c, i, 0});
+            i++;
+        }
+        else if(c == ')' || c == ','){                              //output operators back to the innermost (
+            if(expectOperand){
+                return EVAL_INVALID_EXPR;
+            }
+            while(!ops.isEmpty() && ops.top().code != '('){
+                ops.pop(top);
+                if((status = sink.apply(top.code, top.pos)) != EVAL_OK){
+                    return status;
+                }
+            }
+            if(ops.isEmpty()){                                      //no matching (
+                return EVAL_INVALID_EXPR;
+            }
+            if(c == ','){                                           //next argument, the ( stays
+                ops.top().commas++;
+                expectOperand = true;
+            }
+            else{
+                ops.pop(top);                                       //discard the (
+                const OperatorInfo* function = ops.isEmpty() ? nullptr : operatorByCode(ops.top().code);
+                if(function != nullptr && function->function){      //the ( belonged to a function call
+                    if(top.commas + 1 != function->arity){
+                        return EVAL_INVALID_EXPR;
+                    }
+                    ops.pop(top);
+                    if((status = sink.apply(top.code, top.pos)) != EVAL_OK){
+                        return status;
                     }
-                    stack.pop(top);                                 //discard the (
                 }
-                else if(c == '*' || c == '/'){                      //if c is * or /
-                    while(stack.top() == '*' || stack.top() == '/'){//while the top of the stack is an equivalent
-                        stack.pop(top);                             //operator, pop it from the stack and append to
-                        postfix += top;                             //the postfix string
-                    }                       
-                    stack.push(c);                                  //push c to the top of the stack
+                else if(top.commas > 0){                            //a comma inside plain parentheses
+                    return EVAL_INVALID_EXPR;
                 }
-                else if(c == '+' || c == '-'){                      //if c is + or -
-                    //while the top of the stack is an equivalent or greater operator, pop it from the stack
-                    //and append it the postfix string
-                    while(stack.top() == '*' || stack.top() == '/' || stack.top() == '+' || stack.top() == '-'){
-                        stack.pop(top);
-                        postfix += top;
-                    }
-                    stack.push(c);                                  //push c to the top of the stack
+            }
+            i++;
+        }
+        else if(expectOperand && c == '-'){                         //a minus where an operand belongs is unary
+            ops.push({'~', i, 0});                                  //prefix operators apply nothing yet
+            i++;
+        }
+        else{
+            const OperatorInfo* info = matchBinaryOperator(expr, i, length);
+            if(info == nullptr){                                    //not a legitimate character
+                return EVAL_INVALID_CHAR;
+            }
+            if(expectOperand){                                      //binary operator with no left operand
+                return EVAL_INVALID_EXPR;
+            }
+            //output every operator on the stack that binds tighter, or as tight for left associative operators
+            while(!ops.isEmpty() && ops.top().code != '('){
+                const OperatorInfo* onStack = operatorByCode(ops.top().code);
+                if(onStack->precedence < info->precedence || (onStack->precedence == info->precedence && info->rightAssoc)){
+                    break;
                 }
-                else{                                               //if c is not a legitimate operator,
-                    string error = "Error: Invalid character ";     //error is called and the invalid character is
-                    error += c;                                     //returned from the function
-                    return error;
+                ops.pop(top);
+                if((status = sink.apply(top.code, top.pos)) != EVAL_OK){
+                    return status;
                 }
             }
+            ops.push({info->code, i, 0});
+            i += strlen(info->symbol);
+            expectOperand = true;
+        }
+    }
+    errorPos = length;
+    if(expectOperand){                                              //ends in an operator, or is empty
+        return EVAL_INVALID_EXPR;
+    }
+    while(!ops.isEmpty()){                                          //output the remaining operators
+        ops.pop(top);
+        if(top.code == '('){                                        //an unmatched ( is left over
+            errorPos = top.pos;
+            return EVAL_INVALID_EXPR;
+        }
+        if((status = sink.apply(top.code, top.pos)) != EVAL_OK){
+            return status;
+        }
+    }
+    return sink.finish();
+}
+
+/**
+ * @brief Evaluate an infix expression in a single pass (shunting-yard), without building a postfix string.
+ * An operator stack and a value stack are run together; an operator is applied as soon as it would
+ * have been appended to the postfix output. Nothing is printed.
+ * @param expr pointer to the first character of the expression
+ * @param length number of characters in the expression
+ * @param result gets the evaluated value of the expression (by reference).
+ * @param values value stack to work in. It is cleared first, so one stack can be reused for many expressions.
+ * @param ops operator stack to work in. It is cleared first, so one stack can be reused for many expressions.
+ * @param errorPos gets the offset of the character where an error was found, or length if it was found at the end.
+ * @param vars values of the variables used in the expression, may be nullptr if there are none
+ * @return EVAL_OK if the expression is valid and evaluated without error, otherwise the kind of error.
+ */
+EvalStatus evalInfix(const char* expr, int length, float& result, Stack<float>& values, Stack<OperatorEntry>& ops, int& errorPos,
+                     const Variables* vars) {
+    //neither stack can hold more than one entry per input character, so size them once up front
+    values.clearAll();
+    ops.clearAll();
+    values.reserve(length + 1);
+    ops.reserve(length + 1);
+    ValueSink sink = {values, vars, errorPos};
+    EvalStatus status = shuntingYard(expr, length, ops, sink, errorPos);
+    if(status == EVAL_OK){
+        values.pop(result);
+    }
+    return status;
+}
+
+/**
+ * @brief Convert an infix expression to an equivalent postfix expression
+ * @param expr pointer to the first character of the infix expression
+ * @param length number of characters in the expression
+ * @param postfix gets the postfix expression (by reference). Its previous contents are replaced.
+ * @param errorPos gets the offset of the character where an error was found, or length if it was found at the end.
+ * @return EVAL_OK if the expression is valid, otherwise the kind of error.
+ */
+EvalStatus convertInfix(const char* expr, int length, string& postfix, int& errorPos) {
+    Stack<OperatorEntry> ops(length + 1);
+    postfix.clear();
+    postfix.reserve(length);
+    PostfixStringSink sink = {expr, postfix, 0};
+    return shuntingYard(expr, length, ops, sink, errorPos);
+}
+
+/**
+ * @brief Evaluate a postfix expression
+ * @param expr pointer to the first character of the postfix expression
+ * @param length number of characters in the expression
+ * @param result gets the evaluated value of the expression (by reference).
+ * @param values value stack to work in. It is cleared first, so one stack can be reused for many expressions.
+ * @param errorPos gets the offset of the character where an error was found, or length if it was found at the end.
+ * @return EVAL_OK if the expression is valid and evaluated without error, otherwise the kind of error.
+ */
+EvalStatus evalPostfix(const char* expr, int length, float& result, Stack<float>& values, int& errorPos) {
+    values.clearAll();
+    values.reserve(length + 1);
+    EvalStatus status;
+    for(int i = 0; i < length; i++){                                //iterate through each char in the input
+        char c = expr[i];
+        errorPos = i;
+        if(isdigit(c)){                                             //operands are pushed onto the stack
+            values.push(c - '0');
+        }
+        else if(isBasicOperator(c)){                                //operators replace the top 2 operands with the result
+            if((status = applyOperator(values, c)) != EVAL_OK){
+                return status;
+            }
+        }
+        else{                                                       //not an operator symbol
+            return EVAL_INVALID_CHAR;
         }
     }
-    while(!stack.isEmpty()){                                        //pop remaining elements from the stack and
-        stack.pop(top);                                             //append them to the postfix string
-        postfix += top;
+    errorPos = length;
+    if(values.size() != 1){                                         //exactly one value must remain
+        return EVAL_INVALID_EXPR;
     }
-    return postfix;                                                 //return converted postfix string
+    values.pop(result);
+    return EVAL_OK;
+}
+
+/**
+ * @brief Return a short description of an EvalStatus, for callers that want to print errors
+ * @param status the status to describe
+ * @return the description
+ */
+const char* evalStatusMessage(EvalStatus status) {
+    switch(status){
+    case EVAL_OK:
+        return "ok";
+    case EVAL_INVALID_CHAR:
+        return "invalid character";
+    case EVAL_INVALID_EXPR:
+        return "invalid expression!";
+    case EVAL_DIV_BY_ZERO:
+        return "division by zero";
+    case EVAL_UNKNOWN_VARIABLE:
+        return "unknown variable";
+    }
+    return "unknown error";
+}
+
+/**
+ * @brief Compile an infix expression into a postfix program that runPostfix can evaluate many times
+ * @param expr pointer to the first character of the expression
+ * @param length number of characters in the expression
+ * @param program gets the compiled program (by reference). Its previous contents are replaced.
+ * @param errorPos gets the offset of the character where an error was found, or length if it was found at the end.
+ * @return EVAL_OK if the expression is valid, otherwise the kind of error.
+ */
+EvalStatus compileInfix(const char* expr, int length, PostfixProgram& program, int& errorPos) {
+    Stack<OperatorEntry> ops(length + 1);
+    program.code.clear();
+    program.code.reserve(length);
+    program.variables.clear();
+    program.maxDepth = 0;
+    ProgramSink sink = {program, 0};
+    return shuntingYard(expr, length, ops, sink, errorPos);
 }
 
 /**
- * @brief Evaluate an infix expression. It's converted to a postfix expression first and then evaluated
- * @param infix_expr The input expression in the infix format.
+ * @brief Evaluate a program made by compileInfix
+ * @param program the compiled program
  * @param result gets the evaluated value of the expression (by reference).
- * @return true if expression is valid and evaluation is done without error, otherwise false.
+ * @param errorPos gets the source offset of the instruction that failed
+ * @param vars values of the program's variables, vars[i] for program.variables[i]. May be nullptr if there are none.
+ * @return EVAL_OK, EVAL_DIV_BY_ZERO, or EVAL_UNKNOWN_VARIABLE if vars is nullptr but the program uses variables.
+ * Programs from compileInfix cannot fail in any other way.
  */
-bool evalInfixExpr(string infix_expr, float& result) {
-    string postfix = convertInfixToPostfix(infix_expr);             //convert infix notation to postfix notation
-    return evalPostfixExpr(postfix, result);                        //evalutate postfix input, setting the result to result
-}
\ No newline at end of file
+EvalStatus runPostfix(const PostfixProgram& program, float& result, int& errorPos, const float* vars) {
+    Stack<float> values(program.maxDepth);
+    EvalStatus status;
+    for(const PostfixInstr& instr : program.code){
+        if(instr.op == 0){                                          //operand
+            values.push(instr.value);
+        }
+        else if(instr.op == 'v'){                                   //variable
+            if(vars == nullptr){
+                errorPos = instr.pos;
+                return EVAL_UNKNOWN_VARIABLE;
+            }
+            values.push(vars[instr.slot]);
+        }
+        else if((status = applyOperator(values, instr.op)) != EVAL_OK){
+            errorPos = instr.pos;
+            return status;
+        }
+    }
+    values.pop(result);
+    return EVAL_OK;
+}
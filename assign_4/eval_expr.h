@@ -6,10 +6,60 @@
 #define ASSIGN_4_EVAL_EXPR_H
 
 #include <string>
+#include <unordered_map>
+#include <vector>
+#include "stack.h"
 using namespace std;
 
 /**
- * @brief Evaluate a postfix expression
+ * @brief Result of evaluating an expression
+ */
+enum EvalStatus {
+    EVAL_OK = 0,            // evaluated without error
+    EVAL_INVALID_CHAR,      // a character that does not start any number, name, operator or parenthesis
+    EVAL_INVALID_EXPR,      // missing operands, unbalanced parentheses or leftover operands
+    EVAL_DIV_BY_ZERO,       // division by zero
+    EVAL_UNKNOWN_VARIABLE   // a variable that was not given a value
+};
+
+/**
+ * @brief Values of the variables in an infix expression, by name
+ */
+typedef unordered_map<string, float> Variables;
+
+/**
+ * @brief One step of a compiled postfix program
+ */
+struct PostfixInstr {
+    char op;                // operator code to apply, 0 to push value, or 'v' to push variable number slot
+    int slot;               // variable number when op is 'v', an index into PostfixProgram::variables
+    float value;            // operand value when op is 0
+    int pos;                // offset of the operand or operator in the source expression
+};
+
+/**
+ * @brief An infix expression compiled to postfix form by compileInfix
+ */
+struct PostfixProgram {
+    vector<PostfixInstr> code;
+    vector<string> variables;   // names of the variables used, in order of first use
+    int maxDepth = 0;       // deepest the value stack gets while running the program
+};
+
+/**
+ * @brief An entry of the infix parser's operator stack
+ */
+struct OperatorEntry {
+    char code;              // operator code, or '(' for an open parenthesis
+    int pos;                // offset of the operator or ( in the source expression
+    int commas;             // number of commas seen so far inside a (, 0 for operators
+};
+
+// Functions that print their errors to cout, defined in eval_console.cpp.
+// Use the EvalStatus functions below where errors must be counted or nothing may be printed.
+
+/**
+ * @brief Evaluate a postfix expression, printing an error message if it is invalid
  * @param postfix_expr The input expression in the postfix format.
  * @param result gets the evaluated value of the expression (by reference).
  * @return true if expression is a valid postfix expression and evaluation is done without error, otherwise false.
@@ -19,16 +69,99 @@ bool evalPostfixExpr(string postfix_expr, float& result);
 /**
  * @brief Convert an infix expression to an equivalent postfix expression
  * @param infix_expr The input expression in the infix format.
- * @return the converted postfix expression. If the input infix expression is invalid, return an empty string "";
+ * @return the converted postfix expression. If the input has an invalid character, return "Error: Invalid character "
+ * followed by that character. If the input infix expression is invalid in another way, return an empty string "";
  */
 string convertInfixToPostfix(string infix_expr);
 
 /**
- * @brief Evaluate an infix expression. It's converted to a postfix expression first and then evaluated
+ * @brief Evaluate an infix expression in a single pass, without converting it to a postfix string first.
+ * Prints an error message if the expression is invalid.
  * @param infix_expr The input expression in the infix format.
  * @param result gets the evaluated value of the expression (by reference).
  * @return true if expression is valid and evaluation is done without error, otherwise false.
  */
 bool evalInfixExpr(string infix_expr, float& result);
 
+// Functions that never print, defined in eval_expr.cpp.
+
+/**
+ * @brief Return a short description of an EvalStatus, for callers that want to print errors
+ * @param status the status to describe
+ * @return the description
+ */
+const char* evalStatusMessage(EvalStatus status);
+
+/**
+ * @brief Evaluate a postfix expression of single digits and + - * / without printing anything
+ * @param expr pointer to the first character of the postfix expression
+ * @param length number of characters in the expression
+ * @param result gets the evaluated value of the expression (by reference).
+ * @param values value stack to work in. It is cleared first.
+ * @param errorPos gets the offset of the character where an error was found, or length if it was found at the end.
+ * @return EVAL_OK if the expression is valid and evaluated without error, otherwise the kind of error.
+ */
+EvalStatus evalPostfix(const char* expr, int length, float& result, Stack<float>& values, int& errorPos);
+
+/**
+ * @brief Convert an infix expression to an equivalent postfix expression without printing anything.
+ * Postfix strings only have single digits and + - * /, so other infix expressions give EVAL_INVALID_EXPR.
+ * @param expr pointer to the first character of the infix expression
+ * @param length number of characters in the expression
+ * @param postfix gets the postfix expression (by reference). Its previous contents are replaced.
+ * @param errorPos gets the offset of the character where an error was found, or length if it was found at the end.
+ * @return EVAL_OK if the expression is valid, otherwise the kind of error.
+ */
+EvalStatus convertInfix(const char* expr, int length, string& postfix, int& errorPos);
+
+// Infix expressions accept, from loosest to tightest binding:
+//   == !=    < <= > >=    + -    * /    unary -    ^ (right associative)
+// the functions min(a, b), max(a, b) and abs(a), parentheses, numbers such as 7 or 2.5,
+// and variables (names of letters, digits and _ that start with a letter or _).
+// Comparisons give 1 for true and 0 for false. Spaces and tabs between tokens are ignored.
+
+/**
+ * @brief Check if a character is whitespace between infix tokens. Only spaces and tabs are;
+ * any other control character is EVAL_INVALID_CHAR.
+ */
+inline bool isInfixSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+/**
+ * @brief Evaluate an infix expression in a single pass without printing anything.
+ * Meant for evaluating many expressions: the caller owns the stacks and can reuse them.
+ * @param expr pointer to the first character of the expression
+ * @param length number of characters in the expression
+ * @param result gets the evaluated value of the expression (by reference).
+ * @param values value stack to work in. It is cleared first.
+ * @param ops operator stack to work in. It is cleared first.
+ * @param errorPos gets the offset of the character where an error was found, or length if it was found at the end.
+ * @param vars values of the variables used in the expression, may be nullptr if there are none
+ * @return EVAL_OK if the expression is valid and evaluated without error, otherwise the kind of error.
+ */
+EvalStatus evalInfix(const char* expr, int length, float& result, Stack<float>& values, Stack<OperatorEntry>& ops, int& errorPos,
+                     const Variables* vars = nullptr);
+
+/**
+ * @brief Compile an infix expression into a postfix program that runPostfix can evaluate many times
+ * @param expr pointer to the first character of the expression
+ * @param length number of characters in the expression
+ * @param program gets the compiled program (by reference). Its previous contents are replaced.
+ * @param errorPos gets the offset of the character where an error was found, or length if it was found at the end.
+ * @return EVAL_OK if the expression is valid, otherwise the kind of error.
+ */
+EvalStatus compileInfix(const char* expr, int length, PostfixProgram& program, int& errorPos);
+
+/**
+ * @brief Evaluate a program made by compileInfix
+ * @param program the compiled program
+ * @param result gets the evaluated value of the expression (by reference).
+ * @param errorPos gets the source offset of the instruction that failed
+ * @param vars values of the program's variables, vars[i] for program.variables[i]. May be nullptr if there are none.
+ * @return EVAL_OK, EVAL_DIV_BY_ZERO, or EVAL_UNKNOWN_VARIABLE if vars is nullptr but the program uses variables.
+ * Programs from compileInfix cannot fail in any other way.
+ */
+EvalStatus runPostfix(const PostfixProgram& program, float& result, int& errorPos, const float* vars = nullptr);
+
 #endif //ASSIGN_4_EVAL_EXPR_H
@@ -0,0 +1,209 @@
+/**
+ * Implementation of the ExprCache class
+ */
+#include "expr_cache.h"
+#include <cctype>
+
+/**
+ * @brief The kind of token a character belongs to, for deciding where whitespace matters
+ * @return 0 for part of a number or a name, 1 for ( ) and , which are always tokens on their own,
+ * 2 for anything else, which may be part of an operator such as <= or ==
+ */
+static int charClass(char c) {
+    if(isalnum((unsigned char)c) || c == '_' || c == '.'){
+        return 0;
+    }
+    return (c == '(' || c == ')' || c == ',') ? 1 : 2;
+}
+
+/**
+ * @brief Drop whitespace (spaces and tabs, as in evalInfix) from an expression so equivalent spellings share a cache entry.
+ * Whitespace between two characters of a number or name, or of an operator, is kept as one space,
+ * since "x y" is not "xy" and "< =" is not "<=".
+ * @param expr the expression as written
+ * @param key gets the normalized expression, only written if expr contains whitespace
+ * @param source gets the offset in expr of each character of key, only written if key is
+ * @return expr itself if it is already normalized, otherwise key
+ */
+static const string& normalize(const string& expr, string& key, vector<int>& source) {
+    bool clean = true;
+    for(char c : expr){
+        clean = clean && !isInfixSpace(c);
+    }
+    if(clean){                                              //the common case, no copy
+        return expr;
+    }
+    key.reserve(expr.length());
+    source.reserve(expr.length());
+    int spaceStart = -1;                                    //offset of the whitespace before c, if any
+    for(int i = 0; i < (int)expr.length(); i++){
+        char c = expr[i];
+        if(isInfixSpace(c)){
+            spaceStart = spaceStart < 0 ? i : spaceStart;
+            continue;
+        }
+        if(spaceStart >= 0 && !key.empty() && charClass(key.back()) == charClass(c) && charClass(c) != 1){
+            key += ' ';
+            source.push_back(spaceStart);
+        }
+        spaceStart = -1;
+        key += c;
+        source.push_back(i);
+    }
+    return key;
+}
+
+/**
+ * @brief Constructor
+ * @param capacity maximum number of expressions kept in the cache
+ */
+ExprCache::ExprCache(size_t capacity) : maxEntries(capacity), hitCount(0), missCount(0) {
+}
+
+/**
+ * @brief Return the entry for a normalized expression, compiling and inserting it on a miss
+ * @param key the normalized expression
+ */
+shared_ptr<const ExprCache::Entry> ExprCache::lookup(const string& key) {
+    {
+        lock_guard<mutex> guard(lock);
+        auto found = index.find(key);
+        if(found != index.end()){
+            lru.splice(lru.begin(), lru, found->second);    //move to the front, most recently used
+            hitCount++;
+            return found->second->second;
+        }
+    }
+    //compile outside the lock, so other threads are not held up by the parse
+    missCount++;
+    shared_ptr<Entry> entry = make_shared<Entry>();
+    entry->status = compileInfix(key.data(), key.length(), entry->program, entry->errorPos);
+
+    lock_guard<mutex> guard(lock);
+    auto found = index.find(key);
+    if(found != index.end()){                               //another thread inserted it meanwhile
+        lru.splice(lru.begin(), lru, found->second);
+        return found->second->second;
+    }
+    if(maxEntries > 0){
+        lru.emplace_front(key, entry);
+        index[key] = lru.begin();
+        evict();
+    }
+    return entry;
+}
+
+/**
+ * @brief Evaluate an infix expression, compiling it only if it is not in the cache
+ * @param expr the expression in infix format
+ * @param result gets the evaluated value of the expression (by reference).
+ * @param errorPos gets the offset in expr of the error, if there is one
+ * @param vars values of the variables used in the expression, may be nullptr if there are none
+ * @return EVAL_OK if the expression is valid and evaluated without error, otherwise the kind of error.
+ */
+EvalStatus ExprCache::eval(const string& expr, float& result, int& errorPos, const Variables* vars) {
+    string key;
+    vector<int> source;
+    const string& normalized = normalize(expr, key, source);
+    EvalStatus status = evalNormalized(normalized, result, errorPos, vars);
+    //offsets are into the normalized text, which only differs from expr if whitespace was dropped
+    if(status != EVAL_OK && &normalized == &key){
+        errorPos = errorPos < (int)source.size() ? source[errorPos] : expr.length();
+    }
+    return status;
+}
+
+/**
+ * @brief Evaluate a normalized expression, compiling it only if it is not in the cache
+ * @param key the normalized expression
+ * @param result gets the evaluated value of the expression (by reference).
+ * @param errorPos gets the offset in key of the error, if there is one
+ * @param vars values of the variables used in the expression, may be nullptr if there are none
+ * @return EVAL_OK if the expression is valid and evaluated without error, otherwise the kind of error.
+ */
+EvalStatus ExprCache::evalNormalized(const string& key, float& result, int& errorPos, const Variables* vars) {
+    shared_ptr<const Entry> entry = lookup(key);
+    if(entry->status != EVAL_OK){
+        errorPos = entry->errorPos;
+        return entry->status;
+    }
+    const PostfixProgram& program = entry->program;
+    if(program.variables.empty()){
+        return runPostfix(program, result, errorPos);
+    }
+    //look the variables up by name once, then run on the values in slot order
+    vector<float> bound(program.variables.size());
+    for(size_t slot = 0; slot < bound.size(); slot++){
+        Variables::const_iterator found;
+        if(vars == nullptr || (found = vars->find(program.variables[slot])) == vars->end()){
+            for(const PostfixInstr& instr : program.code){  //report where the variable is first used
+                if(instr.op == 'v' && instr.slot == (int)slot){
+                    errorPos = instr.pos;
+                    break;
+                }
+            }
+            return EVAL_UNKNOWN_VARIABLE;
+        }
+        bound[slot] = found->second;
+    }
+    return runPostfix(program, result, errorPos, bound.data());
+}
+
+/**
+ * @brief Return the compiled program for an expression, compiling it only if it is not in the cache
+ * @param expr the expression in infix format
+ * @param status gets EVAL_OK, or the error that made the expression invalid (by reference)
+ * @return the program, or nullptr if the expression is invalid
+ */
+shared_ptr<const PostfixProgram> ExprCache::compile(const string& expr, EvalStatus& status) {
+    string key;
+    vector<int> source;
+    shared_ptr<const Entry> entry = lookup(normalize(expr, key, source));
+    status = entry->status;
+    if(status != EVAL_OK){
+        return nullptr;
+    }
+    //share ownership with the entry, so the program stays alive even if it is evicted
+    return shared_ptr<const PostfixProgram>(entry, &entry->program);
+}
+
+/**
+ * @brief Drop least recently used entries until there are at most maxEntries. Caller holds lock.
+ */
+void ExprCache::evict() {
+    while(lru.size() > maxEntries){
+        index.erase(lru.back().first);
+        lru.pop_back();
+    }
+}
+
+/**
+ * @brief Change the maximum number of cached expressions, evicting entries if needed
+ * @param capacity the new maximum
+ */
+void ExprCache::setCapacity(size_t capacity) {
+    lock_guard<mutex> guard(lock);
+    maxEntries = capacity;
+    evict();
+}
+
+size_t ExprCache::capacity() const {
+    lock_guard<mutex> guard(lock);
+    return maxEntries;
+}
+
+size_t ExprCache::size() const {
+    lock_guard<mutex> guard(lock);
+    return lru.size();
+}
+
+/**
+ * @brief Remove every entry and reset the hit and miss counters
+ */
+void ExprCache::clear() {
+    lock_guard<mutex> guard(lock);
+    lru.clear();
+    index.clear();
+    hitCount = 0;
+    missCount = 0;
+}
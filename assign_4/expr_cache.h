@@ -0,0 +1,119 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file expr_cache.h
+// @brief This file defines ExprCache, a bounded LRU cache from expression text
+//        to the compiled postfix program, so repeated formulas are only parsed once.
+//=======================================================
+
+#ifndef ASSIGN_4_EXPR_CACHE_H
+#define ASSIGN_4_EXPR_CACHE_H
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "eval_expr.h"
+using namespace std;
+
+/**
+ * A thread-safe least-recently-used cache of compiled infix expressions.
+ * Keys are normalized by dropping whitespace, so "1 + 2" and "1+2" share an entry.
+ * (Whitespace between two numbers or names, or between two operator characters, is kept as one space.)
+ * Invalid expressions are cached too, together with their error.
+ */
+class ExprCache {
+private:
+    /**
+     * A compiled expression, or the reason it could not be compiled
+     */
+    struct Entry {
+        EvalStatus status;
+        int errorPos;
+        PostfixProgram program;
+    };
+
+    // entries from most to least recently used
+    typedef list<pair<string, shared_ptr<const Entry>>> LruList;
+    LruList lru;
+    // expression text to its position in lru
+    unordered_map<string, LruList::iterator> index;
+    size_t maxEntries;
+    // guards lru, index and maxEntries
+    mutable mutex lock;
+    atomic<unsigned long> hitCount;
+    atomic<unsigned long> missCount;
+
+    /**
+     * @brief Drop least recently used entries until there are at most maxEntries. Caller holds lock.
+     */
+    void evict();
+
+    /**
+     * @brief Return the entry for a normalized expression, compiling and inserting it on a miss
+     * @param key the normalized expression
+     */
+    shared_ptr<const Entry> lookup(const string& key);
+
+    /**
+     * @brief Evaluate a normalized expression, compiling it only if it is not in the cache
+     * @param key the normalized expression
+     * @param result gets the evaluated value of the expression (by reference).
+     * @param errorPos gets the offset in key of the error, if there is one
+     * @param vars values of the variables used in the expression, may be nullptr if there are none
+     * @return EVAL_OK if the expression is valid and evaluated without error, otherwise the kind of error.
+     */
+    EvalStatus evalNormalized(const string& key, float& result, int& errorPos, const Variables* vars);
+public:
+    /**
+     * @brief Constructor
+     * @param capacity maximum number of expressions kept in the cache
+     */
+    ExprCache(size_t capacity = 4096);
+
+    /**
+     * @brief Evaluate an infix expression, compiling it only if it is not in the cache
+     * @param expr the expression in infix format
+     * @param result gets the evaluated value of the expression (by reference).
+     * @param errorPos gets the offset in expr of the error, if there is one
+     * @param vars values of the variables used in the expression, may be nullptr if there are none
+     * @return EVAL_OK if the expression is valid and evaluated without error, otherwise the kind of error.
+     */
+    EvalStatus eval(const string& expr, float& result, int& errorPos, const Variables* vars = nullptr);
+
+    /**
+     * @brief Return the compiled program for an expression, compiling it only if it is not in the cache
+     * @param expr the expression in infix format
+     * @param status gets EVAL_OK, or the error that made the expression invalid (by reference)
+     * @return the program, or nullptr if the expression is invalid
+     */
+    shared_ptr<const PostfixProgram> compile(const string& expr, EvalStatus& status);
+
+    /**
+     * @brief Change the maximum number of cached expressions, evicting entries if needed
+     * @param capacity the new maximum
+     */
+    void setCapacity(size_t capacity);
+
+    // @brief Maximum number of cached expressions
+    size_t capacity() const;
+
+    // @brief Number of cached expressions
+    size_t size() const;
+
+    // @brief Number of lookups that found the expression in the cache
+    unsigned long hits() const { return hitCount.load(); }
+
+    // @brief Number of lookups that had to compile the expression
+    unsigned long misses() const { return missCount.load(); }
+
+    /**
+     * @brief Remove every entry and reset the hit and miss counters
+     */
+    void clear();
+};
+
+#endif //ASSIGN_4_EXPR_CACHE_H
@@ -7,44 +7,86 @@
 // Your name: Jason Gray
 // Compiler:  g++
 // File type: headher file stack.h
-// @brief This file defines a Stack class that is implemented using an array
+// @brief This file defines a Stack class that is implemented using an array.
+// The first N elements are stored inside the Stack object itself, and the array
+// only moves to the heap when it grows past N.
 //=======================================================
 
 #pragma once
 
 #include <iostream>
+#include <new>
+#include <utility>
 using namespace std;
 
 /**
  * A template Stack class
+ * T: element type
+ * N: number of elements kept inline before the stack moves to the heap (0 = always heap)
  */
-template <typename T> 
+template <typename T, int N = 32>
 class Stack {
 private:
-    // data array
+    // data array, points either at inline_buffer or at a heap allocation
     T* array;
     // Number of elements in use
     int count;
     // allocation size of the array, in number of elements
     int allocation_size;
+    // raw inline storage for the first N elements. Elements are constructed in place on push.
+    alignas(T) unsigned char inline_buffer[(N > 0 ? N : 1) * sizeof(T)];
 
     /**
      * @brief Resize the data array to double its allocation size
      * Make sure to release memory allocation correctly.
      */
     void resizeArray();
+
+    /**
+     * @brief Return a pointer to the inline storage
+     */
+    T* inlineArray() { return reinterpret_cast<T*>(inline_buffer); }
+
+    /**
+     * @brief Point array at the inline storage if capacity fits, otherwise at a new heap allocation
+     * @param capacity minimum number of elements the array must hold
+     */
+    void allocate(int capacity);
+
+    /**
+     * @brief Release the heap allocation, if the array is not inline. Elements must already be destroyed.
+     */
+    void release();
+
+    /**
+     * @brief Take over the elements of stk, leaving stk empty. Used by the move operations.
+     * @param stk the Stack to move from
+     */
+    void moveFrom(Stack<T, N>& stk);
 public:
-    // Constructor
-    Stack(int capacity = 4);
+    // Constructor. The array stays inline unless capacity is more than N.
+    Stack(int capacity = N);
 
     // Destructor
     ~Stack();
     
     // Copy constructor
-    Stack(const Stack<T>& stk);
+    Stack(const Stack<T, N>& stk);
+
+    // Move constructor
+    Stack(Stack<T, N>&& stk);
 
     // Assignment operator
-    Stack<T>& operator = (const Stack<T>& stk);
+    Stack<T, N>& operator = (const Stack<T, N>& stk);
+
+    // Move assignment operator
+    Stack<T, N>& operator = (Stack<T, N>&& stk);
+
+    /**
+     * @brief Make sure the stack can hold at least capacity elements without resizing
+     * @param capacity the number of elements to reserve room for
+     */
+    void reserve(int capacity);
 
     /**
      * @brief Push a value to the stack.
@@ -53,9 +95,23 @@ public:
      */
     void push(const T& val);
 
+    /**
+     * @brief Push a value to the stack by moving it in
+     * @param val Value to be moved onto the stack
+     */
+    void push(T&& val);
+
+    /**
+     * @brief Construct a new element on top of the stack in place
+     * @param args arguments forwarded to the constructor of T
+     * @return reference to the new top element
+     */
+    template <typename... Args>
+    T& emplace(Args&&... args);
+
     /**
      * @brief If not empty, removes and gives back the top element;
-     * @param val variable to receive the popped element (by ref)
+     * @param val variable to receive the popped element (by ref). The element is moved, not copied.
      */
     void pop(T& val);
 
@@ -77,6 +133,12 @@ public:
      */
     int size();
 
+    /**
+     * @brief Returns the number of elements the stack can hold before resizing
+     * @return int the allocation size of the array
+     */
+    int capacity();
+
     /**
      * @brief Display the content of the stack
      */
@@ -88,43 +150,98 @@ public:
     void clearAll();
 };
 
-template <typename T>
-Stack<T>::Stack(int capacity) {
-    array = new T[capacity];                    //set array to size capacity
-    count = 0;                                  //set count to 0, stack is empty
-    allocation_size = capacity;                 //set allocation_size to capacity
+template <typename T, int N>
+Stack<T, N>::Stack(int capacity) {
+    count = 0;                                  //stack is empty
+    allocate(capacity);                         //inline if capacity fits, heap otherwise
 }
 
-template <typename T>
-Stack<T>::~Stack() {
-    delete[] array;                             //delete array allocated in memory
+template <typename T, int N>
+Stack<T, N>::~Stack() {
+    clearAll();                                 //destroy all elements
+    release();                                  //delete array allocated in memory
 }
 
 // @brief Copy constructor
-template <typename T>
-Stack<T>::Stack(const Stack<T>& stk) {
-    count = stk.count;                          
-    array = new T[count];                       //allocate a new array of size count
-    allocation_size = count;                    
+template <typename T, int N>
+Stack<T, N>::Stack(const Stack<T, N>& stk) {
+    count = 0;
+    allocate(stk.count);                        //allocate an array big enough for count
     for(int i=0; i<stk.count; i++){             //copy all elements of other array to this array
-        array[i] = stk.array[i];
+        new (array + i) T(stk.array[i]);
+        count++;
     }
 }
 
-template <typename T>
-Stack<T>& Stack<T>::operator = (const Stack<T>& stk) {
+// @brief Move constructor
+template <typename T, int N>
+Stack<T, N>::Stack(Stack<T, N>&& stk) {
+    count = 0;
+    allocate(0);                                //start out empty and inline
+    moveFrom(stk);
+}
+
+template <typename T, int N>
+Stack<T, N>& Stack<T, N>::operator = (const Stack<T, N>& stk) {
     if(this != &stk){                           //check that this Stack is not the same as other Stack
-        delete[] array;                         //deallocate existing array
-        count = stk.count;                      
-        array = new T[count];                   //allocate a new array of size count
-        allocation_size = count;                
+        clearAll();                             //destroy existing elements
+        reserve(stk.count);                     //make sure there is room for count elements
         for(int i=0; i<stk.count; i++){         //copy all elements of other array to this array
-            this->array[i] = stk.array[i];  
+            new (array + i) T(stk.array[i]);
+            count++;
         }
     }
     return *this;                               //return this Stack
 }
 
+template <typename T, int N>
+Stack<T, N>& Stack<T, N>::operator = (Stack<T, N>&& stk) {
+    if(this != &stk){
+        clearAll();                             //destroy existing elements
+        release();                              //and give back any heap allocation
+        allocate(0);
+        moveFrom(stk);
+    }
+    return *this;
+}
+
+template <typename T, int N>
+void Stack<T, N>::allocate(int capacity) {
+    if(capacity <= N){                          //fits inline, no heap allocation
+        array = inlineArray();
+        allocation_size = N;
+    }
+    else{
+        array = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        allocation_size = capacity;
+    }
+}
+
+template <typename T, int N>
+void Stack<T, N>::release() {
+    if(array != inlineArray()){
+        ::operator delete(array);
+    }
+}
+
+template <typename T, int N>
+void Stack<T, N>::moveFrom(Stack<T, N>& stk) {
+    if(stk.array == stk.inlineArray()){         //inline elements have to be moved one by one
+        for(int i=0; i<stk.count; i++){
+            new (array + i) T(std::move(stk.array[i]));
+            count++;
+        }
+        stk.clearAll();
+    }
+    else{                                       //heap array can be taken over as a whole
+        array = stk.array;
+        count = stk.count;
+        allocation_size = stk.allocation_size;
+        stk.count = 0;
+        stk.allocate(0);                        //stk goes back to its empty inline buffer
+    }
+}
+
 // : Add implementation of remaining Stack functions.
 // For a template class, the implementation should be included in the header file.
 
@@ -132,15 +249,29 @@ Stack<T>& Stack<T>::operator = (const Stack<T>& stk) {
  * @brief Resize the data array to double its allocation size
  * Make sure to release memory allocation correctly.
  */
-template <typename T>
-void Stack<T>::resizeArray() {
-    T* new_array = new T[allocation_size * 2];  //create a new array with double the capacity
-    for (int i = 0; i <= count; i++) {          //copy all elements from existing array
-        new_array[i] = array[i];
+template <typename T, int N>
+void Stack<T, N>::resizeArray() {
+    reserve(allocation_size > 0 ? allocation_size * 2 : 4);
+}
+
+/**
+ * @brief Make sure the stack can hold at least capacity elements without resizing
+ * @param capacity the number of elements to reserve room for
+ */
+template <typename T, int N>
+void Stack<T, N>::reserve(int capacity) {
+    if(capacity <= allocation_size){            //already big enough
+        return;
     }
-    allocation_size *= 2;
-    delete[] array;                             //deallocate existing array
+    //create a new array with the requested capacity
+    T* new_array = static_cast<T*>(::operator new(capacity * sizeof(T)));
+    for (int i = 0; i < count; i++) {           //move all elements from existing array
+        new (new_array + i) T(std::move(array[i]));
+        array[i].~T();
+    }
+    release();                                  //deallocate existing array
     array = new_array;                          //reassign array to new array
+    allocation_size = capacity;
 }
 
 /**
@@ -148,24 +279,73 @@ void Stack<T>::resizeArray() {
  * The array will be resized if it reaches its capcity
  * @param val Value to be pushed onto the stack
  */
-template <typename T>
-void Stack<T>::push(const T& val) {
-   if(allocation_size == count){                //if array is full, resize
+template <typename T, int N>
+void Stack<T, N>::push(const T& val) {
+   if(allocation_size == count){                //if array is full, copy val first since it may live in the array
+    T copy(val);
     resizeArray();
+    new (array + count) T(std::move(copy));
+   }
+   else{
+    new (array + count) T(val);                 //add element to next open spot in array
    }
-   array[count] = val;                          //add element to next open spot in array
    count++;                                     
 }
 
+/**
+ * @brief Push a value to the stack by moving it in
+ * @param val Value to be moved onto the stack
+ */
+template <typename T, int N>
+void Stack<T, N>::push(T&& val) {
+    emplace(std::move(val));
+}
+
+/**
+ * @brief Construct a new element on top of the stack in place
+ * @param args arguments forwarded to the constructor of T
+ * @return reference to the new top element
+ */
+template <typename T, int N>
+template <typename... Args>
+T& Stack<T, N>::emplace(Args&&... args) {
+    if(allocation_size == count){               //if array is full, grow it
+        //args may refer to an element of the array, so the new element is built in the
+        //new array before the old elements are moved out and destroyed
+        int capacity = allocation_size > 0 ? allocation_size * 2 : 4;
+        T* new_array = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        try{
+            new (new_array + count) T(std::forward<Args>(args)...);
+        }
+        catch(...){
+            ::operator delete(new_array);
+            throw;
+        }
+        for (int i = 0; i < count; i++) {
+            new (new_array + i) T(std::move(array[i]));
+            array[i].~T();
+        }
+        release();
+        array = new_array;
+        allocation_size = capacity;
+    }
+    else{
+        new (array + count) T(std::forward<Args>(args)...);
+    }
+    count++;
+    return array[count-1];
+}
+
 /**
  * @brief If not empty, removes and gives back the top element;
- * @param val variable to receive the popped element (by ref)
+ * @param val variable to receive the popped element (by ref). The element is moved, not copied.
  */
-template <typename T>
-void Stack<T>::pop(T& val) {
+template <typename T, int N>
+void Stack<T, N>::pop(T& val) {
     if(!isEmpty()){                             //ensure Stack is not empty
-        val = array[count-1];                   //update val argument with element to be removed
-        count--;                                //decrement count, "removing" the top element
+        val = std::move(array[count-1]);        //update val argument with element to be removed
+        array[count-1].~T();
+        count--;                                //decrement count, removing the top element
     }
 }
 
@@ -173,8 +353,8 @@ void Stack<T>::pop(T& val) {
  * @brief Returns a reference to the top most element of the stack
  * @return reference to top element of the stack
  */
-template <typename T>
-T& Stack<T>::top() {
+template <typename T, int N>
+T& Stack<T, N>::top() {
     return array[count-1];                      //return the element at the top of the Stack
 }
 
@@ -182,8 +362,8 @@ T& Stack<T>::top() {
  * @brief Check if the stack is empty
  * @return true if stack is empty
  */
-template <typename T>
-bool Stack<T>::isEmpty() {
+template <typename T, int N>
+bool Stack<T, N>::isEmpty() {
     return (count == 0);                        
 }
 
@@ -191,16 +371,25 @@ bool Stack<T>::isEmpty() {
  * @brief Returns the number of elements in the stack
  * @return int the number of elements in the stack
  */
-template <typename T>
-int Stack<T>::size() {
+template <typename T, int N>
+int Stack<T, N>::size() {
     return count;
 }
 
+/**
+ * @brief Returns the number of elements the stack can hold before resizing
+ * @return int the allocation size of the array
+ */
+template <typename T, int N>
+int Stack<T, N>::capacity() {
+    return allocation_size;
+}
+
 /**
  * @brief Display the content of the stack
  */
-template <typename T>
-void Stack<T>::displayAll() {
+template <typename T, int N>
+void Stack<T, N>::displayAll() {
     if (count == 0) {
         cout << "Stack is empty" << endl;
     } else {
@@ -214,8 +403,10 @@ void Stack<T>::displayAll() {
 /**
  * @brief Clear the stack to make it empty
  */
-template <typename T>
-void Stack<T>::clearAll() {
-    count = 0;                                  //"remove" all elements by setting count to 0
+template <typename T, int N>
+void Stack<T, N>::clearAll() {
+    for (int i = 0; i < count; i++) {           //destroy every element, the storage is kept
+        array[i].~T();
+    }
+    count = 0;
 }
-
@@ -5,6 +5,7 @@
 #include "stack.h"
 #include <iostream>
 #include "assert.h"
+#include <string>
 
 using namespace std;
 
@@ -59,5 +60,38 @@ int main(int argc, char* argv[]) {
     assert(s2.size() == stack.size());
     assert(s2.top() == stack.top());
 
-    
+    // Test a stack of strings that outgrows its inline buffer
+    cout << "Test emplace, reserve and move with a Stack<string, 2>" << endl;
+    Stack<string, 2> strs;
+    assert(strs.capacity() == 2);
+    strs.emplace(3, 'a');
+    strs.push(string("bb"));
+    strs.push(strs.top());      // pushing an element of the full stack itself
+    assert(strs.size() == 3 && strs.capacity() > 2);
+    strs.reserve(100);
+    assert(strs.capacity() == 100 && strs.top() == "bb");
+    Stack<string, 2> moved(std::move(strs));
+    assert(moved.size() == 3 && strs.size() == 0);
+    string s;
+    moved.pop(s);
+    moved.pop(s);
+    moved.pop(s);
+    assert(s == "aaa" && moved.isEmpty());
+
+    // moving or emplacing the top of a full stack onto itself, at every growth
+    Stack<string, 2> self;
+    self.push(string(40, 'x'));
+    for (int i = 0; i < 20; i++) {
+        if (self.size() == self.capacity()) {
+            if (i % 2 == 0) {
+                self.push(std::move(self.top()));
+            } else {
+                self.emplace(self.top());
+            }
+            assert(self.top() == string(40, 'x'));
+        } else {
+            self.push(string(40, 'x'));
+        }
+    }
+    moved.displayAll();
 }
\ No newline at end of file
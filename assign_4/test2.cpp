@@ -6,6 +6,7 @@
 
 #include "eval_expr.h"
 #include <iostream>
+#include "assert.h"
 using namespace std;
 
 void testExpression(string expr) {
@@ -30,5 +31,15 @@ int main(int argc, char *argv[])
     testExpression("25*9+2/7+8-");
     testExpression("25@");
     testExpression("25*0/");
+
+    // The non-printing version reports the kind of error and where it is
+    Stack<float> values;
+    float result = 0;
+    int errorPos = -1;
+    assert(evalPostfix("34+5*", 5, result, values, errorPos) == EVAL_OK && result == 35);
+    assert(evalPostfix("34+5*+", 6, result, values, errorPos) == EVAL_INVALID_EXPR && errorPos == 5);
+    assert(evalPostfix("25@", 3, result, values, errorPos) == EVAL_INVALID_CHAR && errorPos == 2);
+    assert(evalPostfix("25*0/", 5, result, values, errorPos) == EVAL_DIV_BY_ZERO && errorPos == 4);
+    assert(evalPostfix("34", 2, result, values, errorPos) == EVAL_INVALID_EXPR && errorPos == 2);
     return 0;
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
  */
 #include "eval_expr.h"
 #include <iostream>
+#include <string.h>
+#include "assert.h"
 using namespace std;
 
 void testInfixExpression(string expr) {
@@ -34,5 +36,20 @@ int main(int argc, char *argv[])
     testInfixExpression("(3+4)*5+6/(7+8)");
     testInfixExpression("(3+4)*5+6/(7+8)-9");
     testInfixExpression("(3+4)*5+6/(7+8)9");*/
+
+    // a division by zero is reported at the operator, by evalInfix and by a compiled program alike
+    const char* divisions[] = {"3/0", "1+3/0+4", "(2)/(1-1)*5"};
+    const int operatorPos[] = {1, 3, 3};
+    Stack<float> values;
+    Stack<OperatorEntry> ops;
+    for (int i = 0; i < 3; i++) {
+        float result = 0;
+        int errorPos = -1, programPos = -1;
+        assert(evalInfix(divisions[i], strlen(divisions[i]), result, values, ops, errorPos) == EVAL_DIV_BY_ZERO);
+        assert(errorPos == operatorPos[i]);
+        PostfixProgram program;
+        assert(compileInfix(divisions[i], strlen(divisions[i]), program, programPos) == EVAL_OK);
+        assert(runPostfix(program, result, programPos) == EVAL_DIV_BY_ZERO && programPos == operatorPos[i]);
+    }
     return 0;
 }
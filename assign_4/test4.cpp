@@ -0,0 +1,85 @@
+/**
+ * This file tests the concurrent stacks TreiberStack and BoundedStack
+ *
+ */
+#include "concurrent_stack.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "assert.h"
+
+using namespace std;
+
+/**
+ * @brief Have each thread push its own range of values and pop as many values as it pushed,
+ * then check that every value was popped exactly once
+ */
+template <typename StackType>
+void testManyThreads(StackType& stack, int threads, int perThread) {
+    vector<vector<int>> popped(threads);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&, t]() {
+            for (int i = 0; i < perThread; i++) {
+                while (!stack.push(t * perThread + i)) {}  // bounded stack may be full for a moment
+                int x;
+                if (i % 2 == 1) {                           // pop two values every second push
+                    while (!stack.pop(x)) {}
+                    popped[t].push_back(x);
+                    while (!stack.pop(x)) {}
+                    popped[t].push_back(x);
+                }
+            }
+        }));
+    }
+    for (thread& w : workers) {
+        w.join();
+    }
+    assert(stack.isEmpty() && stack.size() == 0);
+    vector<int> seen(threads * perThread, 0);
+    for (vector<int>& values : popped) {
+        for (int x : values) {
+            seen[x]++;
+        }
+    }
+    for (int n : seen) {
+        assert(n == 1);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    cout << "Test TreiberStack with a single thread" << endl;
+    TreiberStack<string> strs;
+    string s;
+    assert(strs.isEmpty() && !strs.pop(s));
+    for (int i = 0; i < 1000; i++) {
+        strs.push(to_string(i));
+    }
+    assert(strs.size() == 1000);
+    strs.pop(s);
+    assert(s == "999" && strs.size() == 999);
+    strs.emplace(3, 'x');
+    strs.pop(s);
+    assert(s == "xxx");
+
+    cout << "Test BoundedStack fills up at its capacity" << endl;
+    BoundedStack<int> bounded(3);
+    int x = 0;
+    assert(bounded.push(1) && bounded.push(2) && bounded.push(3));
+    assert(!bounded.push(4));
+    assert(bounded.top(x) && x == 3);
+    bounded.pop(x);
+    assert(x == 3 && bounded.push(5) && bounded.top(x) && x == 5);
+
+    cout << "Test TreiberStack with 8 threads" << endl;
+    TreiberStack<int> treiber;
+    testManyThreads(treiber, 8, 100000);
+
+    cout << "Test BoundedStack with 8 threads" << endl;
+    BoundedStack<int> shared(64);
+    testManyThreads(shared, 8, 100000);
+
+    cout << "Success" << endl;
+    return 0;
+}
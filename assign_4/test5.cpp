@@ -0,0 +1,135 @@
+/**
+ * This file tests the expression cache
+ *
+ */
+#include "expr_cache.h"
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "assert.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    ExprCache cache(2);
+    float result = 0;
+    int errorPos = -1;
+
+    cout << "Test a repeated expression is compiled once" << endl;
+    assert(cache.eval("(3+4)*5", result, errorPos) == EVAL_OK && result == 35);
+    assert(cache.eval("(3 + 4) * 5", result, errorPos) == EVAL_OK && result == 35);
+    assert(cache.hits() == 1 && cache.misses() == 1 && cache.size() == 1);
+
+    cout << "Test errors are cached and reported with their position" << endl;
+    assert(cache.eval("3+4&9", result, errorPos) == EVAL_INVALID_CHAR && errorPos == 3);
+    assert(cache.eval("3+4&9", result, errorPos) == EVAL_INVALID_CHAR && errorPos == 3);
+    assert(cache.eval("8/(4-4)", result, errorPos) == EVAL_DIV_BY_ZERO && errorPos == 1);
+    assert(cache.hits() == 2 && cache.misses() == 3);
+
+    cout << "Test the least recently used expression is evicted" << endl;
+    assert(cache.size() == 2);
+    cache.eval("(3+4)*5", result, errorPos);        // was evicted by 8/(4-4)
+    assert(cache.misses() == 4);
+    cache.setCapacity(1);
+    assert(cache.size() == 1 && cache.capacity() == 1);
+    cache.eval("(3+4)*5", result, errorPos);
+    assert(cache.hits() == 3);
+
+    cout << "Test a compiled program outlives its cache entry" << endl;
+    EvalStatus status;
+    shared_ptr<const PostfixProgram> program = cache.compile("9-2*3", status);
+    assert(status == EVAL_OK && program != nullptr);
+    cache.clear();
+    assert(cache.size() == 0 && cache.hits() == 0 && cache.misses() == 0);
+    assert(runPostfix(*program, result, errorPos) == EVAL_OK && result == 3);
+    assert(cache.compile("9-", status) == nullptr && status == EVAL_INVALID_EXPR);
+
+    cout << "Test the cache shared by 4 threads" << endl;
+    ExprCache shared(16);
+    vector<thread> workers;
+    for (int t = 0; t < 4; t++) {
+        workers.push_back(thread([&shared]() {
+            for (int i = 0; i < 10000; i++) {
+                string expr = to_string(i % 32 % 10) + "+" + to_string(i % 32 / 10);
+                float value = 0;
+                int pos;
+                assert(shared.eval(expr, value, pos) == EVAL_OK && value == i % 32 % 10 + i % 32 / 10);
+            }
+        }));
+    }
+    for (thread& w : workers) {
+        w.join();
+    }
+    assert(shared.hits() + shared.misses() == 40000 && shared.size() == 16);
+
+    cout << "Test the extended grammar" << endl;
+    ExprCache grammar(32);
+    assert(grammar.eval("2^3^2", result, errorPos) == EVAL_OK && result == 512);
+    assert(grammar.eval("-2^2", result, errorPos) == EVAL_OK && result == -4);
+    assert(grammar.eval("3--2", result, errorPos) == EVAL_OK && result == 5);
+    assert(grammar.eval("12.5*2 + 100", result, errorPos) == EVAL_OK && result == 125);
+    assert(grammar.eval("1+2*3 <= 7", result, errorPos) == EVAL_OK && result == 1);
+    assert(grammar.eval("4 != 2+2", result, errorPos) == EVAL_OK && result == 0);
+    assert(grammar.eval("max(2, min(7, 5)) + abs(-3)", result, errorPos) == EVAL_OK && result == 8);
+    assert(grammar.eval("max(1)", result, errorPos) == EVAL_INVALID_EXPR);
+    assert(grammar.eval("abs 3", result, errorPos) == EVAL_INVALID_EXPR);
+    assert(grammar.eval("2 3", result, errorPos) == EVAL_INVALID_EXPR);
+
+    cout << "Test the cache accepts the same spellings as evalInfix" << endl;
+    Stack<float> values;
+    Stack<OperatorEntry> ops;
+    const char* spellings[] = {"1 < = 2", "1 = = 1", "2 ! = 3", "3 > = 1", "1 <= 2", "2 != 3", "3 - -2", "3 - - 2",
+                               "max( 2 , 3 )", "2 .5", "x y", " 7 ", "1 <\t= 2", "4 ^ 2 ^ 0.5"};
+    for (const char* spelling : spellings) {
+        float cached = 0, direct = 0;
+        int cachedPos, directPos;
+        Variables xy = {{"x", 1}, {"y", 2}};
+        EvalStatus status = grammar.eval(spelling, cached, cachedPos, &xy);
+        assert(status == evalInfix(spelling, strlen(spelling), direct, values, ops, directPos, &xy));
+        assert(status != EVAL_OK || cached == direct);
+    }
+    //errors are reported at offsets into the text as written, like evalInfix
+    const char* spaced[] = {"8 / (4 - 4)", "  3 + 4 & 9", "1 +  2 *", "x  +  y", "max( 1 ,2 ) ) ", "2 ! = 3",
+                            "\t( 1 + 2"};
+    for (const char* spelling : spaced) {
+        float cached = 0, direct = 0;
+        int cachedPos = -1, directPos = -2;
+        EvalStatus status = grammar.eval(spelling, cached, cachedPos);
+        assert(status != EVAL_OK);
+        assert(status == evalInfix(spelling, strlen(spelling), direct, values, ops, directPos));
+        assert(cachedPos == directPos);
+    }
+
+    //only spaces and tabs separate tokens, in the cache as in evalInfix
+    const char* whitespace = " \t\n\r\v\f";
+    for (const char* w = whitespace; *w; w++) {
+        for (string spelling : {string("1+") + *w + "2", string(1, *w) + "3*4", string("5") + *w}) {
+            float cached = 0, direct = 0;
+            int cachedPos, directPos;
+            EvalStatus status = grammar.eval(spelling, cached, cachedPos);
+            assert(status == evalInfix(spelling.data(), spelling.length(), direct, values, ops, directPos));
+            assert((status == EVAL_OK) == (*w == ' ' || *w == '\t'));
+            assert(status != EVAL_OK || cached == direct);
+        }
+    }
+
+    cout << "Test variables are bound at evaluation time" << endl;
+    Variables vars = {{"x", 3}, {"rate", 0.5f}};
+    assert(grammar.eval("x^2 + rate*4", result, errorPos, &vars) == EVAL_OK && result == 11);
+    vars["x"] = 4;
+    assert(grammar.eval("x^2 + rate*4", result, errorPos, &vars) == EVAL_OK && result == 18);
+    assert(grammar.eval("x+y", result, errorPos, &vars) == EVAL_UNKNOWN_VARIABLE && errorPos == 2);
+    assert(grammar.eval("x", result, errorPos) == EVAL_UNKNOWN_VARIABLE && errorPos == 0);
+    program = grammar.compile("min(x, y) * 2", status);
+    assert(status == EVAL_OK && program->variables.size() == 2);
+    float slots[2] = {0, 0};
+    for (size_t v = 0; v < program->variables.size(); v++) {
+        slots[v] = program->variables[v] == "x" ? 6 : 9;
+    }
+    assert(runPostfix(*program, result, errorPos, slots) == EVAL_OK && result == 12);
+
+    cout << "Success" << endl;
+    return 0;
+}
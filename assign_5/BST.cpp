@@ -11,6 +11,7 @@
 //=======================================================
 
 #include "BST.h"
+#include <algorithm>
 #include <vector>
 #include <iostream>
 
@@ -54,12 +55,41 @@ void BST::clear(Node* node) {
     if(node == nullptr){
         return;
     }
-    else{
-        //recursively clear all left and right subtrees of node
-        clear(node->leftChild);
-        clear(node->rightChild);
+    //an unbalanced BST can be as deep as it is large, so nodes are deleted in postorder
+    //by following parent pointers instead of recursing
+    Node* stop = node->parent;
+    Node* curNode = node;
+    while(curNode != stop){
+        if(curNode->leftChild != nullptr){
+            curNode = curNode->leftChild;
+        }
+        else if(curNode->rightChild != nullptr){
+            curNode = curNode->rightChild;
+        }
+        else{
+            //a leaf: unlink it from its parent, delete it, and continue from the parent
+            Node* parent = curNode->parent;
+            if(parent != stop){
+                if(parent->leftChild == curNode){
+                    parent->leftChild = nullptr;
+                }
+                else{
+                    parent->rightChild = nullptr;
+                }
+            }
+            delete curNode;
+            curNode = parent;
+        }
+    }
+    //the cleared subtree is gone, so its parent no longer points to it
+    if(stop != nullptr){
+        if(stop->leftChild == node){
+            stop->leftChild = nullptr;
+        }
+        else if(stop->rightChild == node){
+            stop->rightChild = nullptr;
+        }
     }
-    delete node;
 }
 
 /**
@@ -109,6 +139,93 @@ bool BST::insert(T element) {
     return false;
 }
 
+/**
+ * @brief Replace the contents of this BST with a height-balanced tree of sorted elements in O(n)
+ * @param sorted elements in ascending order. Repeated elements are all kept, as insert does.
+ * @param n number of elements
+ */
+void BST::buildFromSorted(const T* sorted, size_t n) {
+    clear();
+    root = buildSubtree(sorted, 0, n, nullptr);
+    numElements = n;
+}
+
+/**
+ * @brief Replace the contents of this BST with a height-balanced tree of the elements
+ * @param elements elements in any order. Repeated elements are all kept, as insert does.
+ * @param n number of elements
+ */
+void BST::buildFromUnsorted(const T* elements, size_t n) {
+    std::vector<T> sorted(elements, elements + n);
+    std::sort(sorted.begin(), sorted.end());
+    buildFromSorted(sorted.data(), sorted.size());
+}
+
+/**
+ * @brief Build a balanced subtree from sorted[lo, hi), taking the middle element as its root.
+ * insert sends equal keys right, so when the middle element repeats, the root is moved back
+ * to the first of its run of equal keys and all its copies land in the right subtree.
+ * @param sorted elements in ascending order
+ * @param lo index of the first element of the subtree
+ * @param hi index past the last element of the subtree
+ * @param parent the parent of the subtree root
+ * @return the root of the subtree, nullptr if lo == hi
+ */
+BST::Node* BST::buildSubtree(const T* sorted, size_t lo, size_t hi, Node* parent) {
+    //the left part is never more than half the range, so only it is built recursively and the
+    //right part is built by the loop. The recursion stays log n deep even when a long run of
+    //repeats pushes the roots to the left end of their ranges.
+    Node* top = nullptr;
+    Node** link = &top;
+    while(lo < hi){
+        size_t mid = lo + (hi - lo) / 2;
+        if(mid > lo && sorted[mid - 1] == sorted[mid]){
+            mid = std::lower_bound(sorted + lo, sorted + mid, sorted[mid]) - sorted;
+        }
+        Node* node = new Node(sorted[mid]);
+        node->parent = parent;
+        node->leftChild = buildSubtree(sorted, lo, mid, node);
+        *link = node;
+        link = &node->rightChild;
+        parent = node;
+        lo = mid + 1;
+    }
+    return top;
+}
+
+/**
+ * @brief Return an iterator to the smallest element
+ * @return the first iterator, equal to end() if the BST is empty
+ */
+BST::Iterator BST::begin() const {
+    Node* curNode = root;
+    while(curNode != nullptr && curNode->leftChild != nullptr){
+        curNode = curNode->leftChild;
+    }
+    return Iterator(curNode);
+}
+
+/**
+ * @brief Find the first element that is not less than key
+ * @param key the key to search for
+ * @return iterator to the element, end() if every element is less than key
+ */
+BST::Iterator BST::lower_bound(const T &key) const {
+    Node* found = nullptr;
+    Node* curNode = root;
+    while(curNode != nullptr){
+        //a node not less than key is a candidate, but a smaller one may be on its left
+        if(curNode->data < key){
+            curNode = curNode->rightChild;
+        }
+        else{
+            found = curNode;
+            curNode = curNode->leftChild;
+        }
+    }
+    return Iterator(found);
+}
+
 /**
  * @brief Find a query element in this BST
  * @param query The query element to find
@@ -173,11 +290,19 @@ BST::Node* BST::getRoot() {
  * @param node a pointer to node in BST
  */
 void BST::printInorder(Node* node) {
-    //recursively iterate through left subtree, then visit the node, then recursively iterate through right subtree
+    //walk the subtree in order from its leftmost node to its rightmost node with nextInorder,
+    //so a deep unbalanced subtree cannot overflow the call stack
     if(node != nullptr){
-        printInorder(node->leftChild);
-        std::cout << node->data << " ";
-        printInorder(node->rightChild);
+        Node* last = node;
+        while(last->rightChild != nullptr){
+            last = last->rightChild;
+        }
+        for(Node* curNode = getLeftMostNode(node); ; curNode = nextInorder(curNode)){
+            std::cout << curNode->data << " ";
+            if(curNode == last){
+                break;
+            }
+        }
     }
 }
 
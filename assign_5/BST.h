@@ -11,6 +11,9 @@
 #ifndef ASSIGN_5_BST_H
 #define ASSIGN_5_BST_H
 
+#include <cstddef>
+#include <iterator>
+
 // T: element data type
 // int for node element type now, but can be changed to any data type.
 typedef int T;
@@ -52,6 +55,55 @@ public:
 
     };
 
+    /**
+     * Read-only iterator over the elements in ascending order.
+     * Moving to the next element follows child and parent pointers,
+     * so iterating uses no recursion, no stack and no allocation.
+     */
+    class Iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        /**
+         * @brief Iterator constructor
+         * @param node the node to start at, nullptr for the end
+         */
+        Iterator(Node* node = nullptr) : node(node) {}
+
+        const T& operator*() const { return node->data; }
+        const T* operator->() const { return &node->data; }
+
+        /**
+         * @brief Move to the next element in ascending order
+         */
+        Iterator& operator++() {
+            node = nextInorder(node);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            node = nextInorder(node);
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+
+        /**
+         * @brief Return the node the iterator is at
+         * @return the node, nullptr at the end
+         */
+        Node* getNode() const { return node; }
+
+    private:
+        Node* node;
+    };
+
     /**
      * BST Constructor, which should initialize an empty BST
      */
@@ -69,6 +121,53 @@ public:
      */
     bool insert(T element);
 
+    /**
+     * @brief Replace the contents of this BST with a height-balanced tree of sorted elements.
+     * Takes O(n) time: every node is created once, in place, with no searching. A run of
+     * repeated elements costs a binary search for the first copy, which becomes the subtree root.
+     * @param sorted elements in ascending order. Repeated elements are all kept, as insert does.
+     * @param n number of elements
+     */
+    void buildFromSorted(const T* sorted, size_t n);
+
+    /**
+     * @brief Replace the contents of this BST with a height-balanced tree of the elements.
+     * Sorts a copy of the elements, then calls buildFromSorted, so it takes O(n log n) time.
+     * @param elements elements in any order. Repeated elements are all kept, as insert does.
+     * @param n number of elements
+     */
+    void buildFromUnsorted(const T* elements, size_t n);
+
+    /**
+     * @brief Return an iterator to the smallest element
+     * @return the first iterator, equal to end() if the BST is empty
+     */
+    Iterator begin() const;
+
+    /**
+     * @brief Return the iterator past the largest element
+     * @return the end iterator
+     */
+    Iterator end() const;
+
+    /**
+     * @brief Find the first element that is not less than key
+     * @param key the key to search for
+     * @return iterator to the element, end() if every element is less than key
+     */
+    Iterator lower_bound(const T & key) const;
+
+    /**
+     * @brief Call callback on every element e with lo <= e <= hi, in ascending order.
+     * Costs O(log n + k) for k elements in the range, without recursion or allocation.
+     * @param lo lower bound of the range
+     * @param hi upper bound of the range
+     * @param callback function taking a const T&
+     * @return the number of elements passed to callback
+     */
+    template <typename Callback>
+    unsigned int rangeScan(const T & lo, const T & hi, Callback callback) const;
+
     /**
      * @brief Find a query element in this BST
      * @param query The query element to find
@@ -151,6 +250,24 @@ public:
     Node* successor(Node *node);
 
 private:
+    /**
+     * @brief Build a balanced subtree from sorted[lo, hi), taking the middle element, or the first
+     * copy of it when it repeats, as its root
+     * @param sorted elements in ascending order
+     * @param lo index of the first element of the subtree
+     * @param hi index past the last element of the subtree
+     * @param parent the parent of the subtree root
+     * @return the root of the subtree, nullptr if lo == hi
+     */
+    Node* buildSubtree(const T* sorted, size_t lo, size_t hi, Node* parent);
+
+    /**
+     * @brief Return the node after node in ascending order, or nullptr if node holds the largest element
+     * @param node a node in the BST
+     * @return the next node
+     */
+    static Node* nextInorder(Node* node);
+
     /**
      * Pointer to the root node of this BST
      */
@@ -163,4 +280,52 @@ private:
 
 };
 
+// Stepping an iterator is inlined into loops over the BST, so nextInorder and end are defined here.
+
+/**
+ * @brief Return the node after node in ascending order, or nullptr if node holds the largest element
+ * @param node a node in the BST
+ * @return the next node
+ */
+inline BST::Node* BST::nextInorder(Node* node) {
+    //the next node is the leftmost node of the right subtree if there is one
+    if (node->rightChild != nullptr) {
+        node = node->rightChild;
+        while (node->leftChild != nullptr) {
+            node = node->leftChild;
+        }
+        return node;
+    }
+    //otherwise it is the first ancestor that has node in its left subtree
+    while (node->parent != nullptr && node->parent->rightChild == node) {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+/**
+ * @brief Return the iterator past the largest element
+ * @return the end iterator
+ */
+inline BST::Iterator BST::end() const {
+    return Iterator(nullptr);
+}
+
+/**
+ * @brief Call callback on every element e with lo <= e <= hi, in ascending order
+ * @param lo lower bound of the range
+ * @param hi upper bound of the range
+ * @param callback function taking a const T&
+ * @return the number of elements passed to callback
+ */
+template <typename Callback>
+unsigned int BST::rangeScan(const T & lo, const T & hi, Callback callback) const {
+    unsigned int count = 0;
+    for (Iterator it = lower_bound(lo); it != end() && !(hi < *it); ++it) {
+        callback(*it);
+        count++;
+    }
+    return count;
+}
+
 #endif //ASSIGN_5_BST_H
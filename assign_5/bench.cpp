@@ -0,0 +1,252 @@
+/**
+ * Benchmarks for the BST.
+ * Usage: ./bench <benchmark> [number of keys]     (default 10^6 keys)
+ *
+ *   build   an insert loop against buildFromSorted and buildFromUnsorted. The insert loop
+ *           gets the keys in random order; inserting them sorted would give the unbalanced
+ *           BST a linked list and take quadratic time.
+ *   scan    full in-order scans with the iterator against a recursive traversal, and
+ *           rangeScan over ranges of 1000 elements. Inserting in random order scatters
+ *           consecutive keys over the heap; a bulk-loaded tree is scanned too for comparison.
+ *   mixed   operations per second from 1 to 32 threads on a tree of n random keys, all finds
+ *           and 90% finds with 5% inserts and 5% removes, for ConcurrentBST against the same
+ *           tree with every find behind one mutex too. BST has no remove, so it cannot run the
+ *           mixed load. The removes keep the tree near n keys and exercise epoch reclamation.
+ */
+#include "BST.h"
+#include "concurrent_bst.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Time one way of building a tree and print the rate and the resulting height
+ * @param name name of the build
+ * @param build function that fills the tree
+ */
+template <typename Build>
+void run(const char* name, size_t n, Build build) {
+    BST bst;
+    auto start = chrono::steady_clock::now();
+    build(bst);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << name << ": " << elapsed.count() * 1e3 << " ms, " << n / elapsed.count() / 1e6
+         << " M keys/s, height " << bst.height() << endl;
+}
+
+/**
+ * @brief Compare an insert loop with the bulk builds
+ */
+void benchBuild(int n) {
+    mt19937 rng(1);
+    vector<T> sorted(n);
+    for (int i = 0; i < n; i++) {
+        sorted[i] = i;
+    }
+    vector<T> shuffled = sorted;
+    shuffle(shuffled.begin(), shuffled.end(), rng);
+
+    cout << n << " keys" << endl;
+    run("insert loop, random order", n, [&](BST& bst) {
+        for (T key : shuffled) {
+            bst.insert(key);
+        }
+    });
+    run("buildFromSorted          ", n, [&](BST& bst) { bst.buildFromSorted(sorted.data(), n); });
+    run("buildFromUnsorted        ", n, [&](BST& bst) { bst.buildFromUnsorted(shuffled.data(), n); });
+}
+
+/**
+ * @brief Sum a subtree with a recursive in-order traversal
+ */
+long sumRecursive(BST::Node* node) {
+    if (node == nullptr) {
+        return 0;
+    }
+    return sumRecursive(node->leftChild) + node->data + sumRecursive(node->rightChild);
+}
+
+/**
+ * @brief Time full scans of a tree with its iterator
+ * @param name name printed for the scan
+ * @param bst the tree
+ * @param scans number of scans to run
+ */
+void runIteratorScan(const char* name, BST& bst, int scans) {
+    auto start = chrono::steady_clock::now();
+    long sum = 0;
+    for (int i = 0; i < scans; i++) {
+        for (T element : bst) {
+            sum += element;
+        }
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << name << ": " << scans / elapsed.count() << " scans/s, "
+         << (double)scans * bst.size() / elapsed.count() / 1e6 << " M elements/s (checksum " << sum << ")" << endl;
+}
+
+/**
+ * @brief Time full scans and range scans
+ */
+void benchScan(int n) {
+    mt19937 rng(1);
+    vector<T> keys(n);
+    for (int i = 0; i < n; i++) {
+        keys[i] = i;
+    }
+    shuffle(keys.begin(), keys.end(), rng);
+    BST bst;
+    for (T key : keys) {
+        bst.insert(key);
+    }
+    const int scans = 20;
+
+    cout << n << " keys" << endl;
+    runIteratorScan("iterator scan ", bst, scans);
+    chrono::steady_clock::time_point start;
+    chrono::duration<double> elapsed;
+    long sum;
+
+    start = chrono::steady_clock::now();
+    sum = 0;
+    for (int i = 0; i < scans; i++) {
+        sum += sumRecursive(bst.getRoot());
+    }
+    elapsed = chrono::steady_clock::now() - start;
+    cout << "recursive scan: " << scans / elapsed.count() << " scans/s, "
+         << (double)scans * n / elapsed.count() / 1e6 << " M elements/s (checksum " << sum << ")" << endl;
+
+    const int ranges = 10000;
+    uniform_int_distribution<T> any(0, n - 1000);
+    start = chrono::steady_clock::now();
+    sum = 0;
+    for (int i = 0; i < ranges; i++) {
+        T lo = any(rng);
+        bst.rangeScan(lo, lo + 999, [&sum](const T& element) { sum += element; });
+    }
+    elapsed = chrono::steady_clock::now() - start;
+    cout << "rangeScan     : " << ranges / elapsed.count() / 1e3 << " K ranges/s of 1000 elements (checksum "
+         << sum << ")" << endl;
+
+    sort(keys.begin(), keys.end());
+    BST bulk;
+    bulk.buildFromSorted(keys.data(), n);
+    runIteratorScan("iterator scan, bulk-loaded", bulk, scans);
+}
+
+/**
+ * @brief Run threads doing a mix of operations for a fixed time and print the rate
+ * @param name name of the tree
+ * @param threads number of threads
+ * @param updatePercent percentage of operations that update, half inserts and half removes
+ * @param find function taking a key and returning whether it is in the tree
+ * @param insert function inserting a key
+ * @param remove function removing a key
+ * @param n keys are drawn from [0, 2n)
+ */
+template <typename Find, typename Insert, typename Remove>
+void runMixed(const char* name, int threads, int updatePercent, Find find, Insert insert, Remove remove, int n) {
+    const chrono::milliseconds duration(300);
+    atomic<bool> done(false);
+    atomic<long> operations(0);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&, t]() {
+            mt19937 rng(t + 1);
+            uniform_int_distribution<T> any(0, 2 * n - 1);
+            uniform_int_distribution<int> percent(0, 99);
+            long count = 0, found = 0;
+            while (!done.load(memory_order_relaxed)) {
+                T key = any(rng);
+                int roll = percent(rng);
+                if (roll >= updatePercent) {
+                    found += find(key);
+                } else if (roll % 2 == 0) {
+                    insert(key);
+                } else {
+                    remove(key);
+                }
+                count++;
+            }
+            operations += count + (found < 0);
+        }));
+    }
+    this_thread::sleep_for(duration);
+    done.store(true);
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    cout << name << ", " << (threads < 10 ? " " : "") << threads << (threads == 1 ? " thread : " : " threads: ")
+         << operations / chrono::duration<double>(duration).count() / 1e6 << " M ops/s" << endl;
+}
+
+/**
+ * @brief Compare lock-free finds with finds behind one mutex under a read-only and a mixed load.
+ * Keys are drawn from twice the range of the initial keys, so inserts and removes succeed
+ * equally often and the trees stay near n keys over the runs.
+ */
+void benchMixed(int n) {
+    mt19937 rng(1);
+    vector<T> keys(2 * n);
+    for (int i = 0; i < 2 * n; i++) {
+        keys[i] = i;
+    }
+    shuffle(keys.begin(), keys.end(), rng);
+    keys.resize(n);
+    ConcurrentBST concurrent;
+    ConcurrentBST locked;
+    mutex lock;
+    for (T key : keys) {
+        concurrent.insert(key);
+        locked.insert(key);
+    }
+
+    cout << n << " keys, " << thread::hardware_concurrency() << " hardware threads" << endl;
+    for (int updatePercent : {0, 10}) {
+        cout << 100 - updatePercent << "% finds, " << updatePercent << "% updates" << endl;
+        for (int threads : {1, 2, 4, 8, 16, 32}) {
+            runMixed("ConcurrentBST        ", threads, updatePercent,
+                     [&](T key) { return concurrent.find(key); },
+                     [&](T key) { concurrent.insert(key); },
+                     [&](T key) { concurrent.remove(key); }, n);
+            runMixed("ConcurrentBST + mutex", threads, updatePercent,
+                     [&](T key) {
+                         lock_guard<mutex> guard(lock);
+                         return locked.find(key);
+                     },
+                     [&](T key) {
+                         lock_guard<mutex> guard(lock);
+                         locked.insert(key);
+                     },
+                     [&](T key) {
+                         lock_guard<mutex> guard(lock);
+                         locked.remove(key);
+                     }, n);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    string name = argc > 1 ? argv[1] : "";
+    int n = argc > 2 ? atoi(argv[2]) : 1000000;
+    if (name == "build") {
+        benchBuild(n);
+    } else if (name == "scan") {
+        benchScan(n);
+    } else if (name == "mixed") {
+        benchMixed(n);
+    } else {
+        cerr << "Usage: " << argv[0] << " <build|scan|mixed> [number of keys]" << endl;
+        return 1;
+    }
+    return 0;
+}
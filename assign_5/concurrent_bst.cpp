@@ -0,0 +1,246 @@
+/**
+ * Implementation of ConcurrentBST class.
+ */
+
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: cpp file concurrent_bst.cpp
+// @brief This class implements a BST whose find runs without locks
+//=======================================================
+
+#include "concurrent_bst.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+/**
+ * @brief ConcurrentBST default constructor. An empty tree in epoch 1 with every reader slot free.
+ */
+ConcurrentBST::ConcurrentBST() : root(nullptr), version(0), epoch(1), numElements(0), numRetired(0) {
+    for (Slot& slot : slots) {
+        slot.epoch.store(0);
+    }
+}
+
+/**
+ * @brief ConcurrentBST destructor. Frees the tree and every retired node.
+ */
+ConcurrentBST::~ConcurrentBST() {
+    clear(root.load());
+    for (Retired& group : retired) {
+        for (Node* node : group.nodes) {
+            delete node;
+        }
+    }
+}
+
+/**
+ * @brief Delete all nodes of a subtree
+ * @param node the subtree root
+ */
+void ConcurrentBST::clear(Node* node) {
+    //the tree is unbalanced and can be as deep as it is large, and nodes have no parent pointers,
+    //so left children are rotated up until the node has none, then it is deleted and its right
+    //subtree cleared the same way. Each rotation moves one node off the left spine, so this is O(n).
+    while (node != nullptr) {
+        Node* left = node->leftChild.load(std::memory_order_relaxed);
+        if (left != nullptr) {
+            node->leftChild.store(left->rightChild.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            left->rightChild.store(node, std::memory_order_relaxed);
+            node = left;
+        } else {
+            Node* right = node->rightChild.load(std::memory_order_relaxed);
+            delete node;
+            node = right;
+        }
+    }
+}
+
+/**
+ * @brief Return the number of elements in the BST
+ * @return The number of elements in the BST
+ */
+unsigned int ConcurrentBST::size() const {
+    return numElements.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Return the number of removed nodes still waiting for running finds to finish
+ */
+size_t ConcurrentBST::retiredNodes() const {
+    return numRetired;
+}
+
+/**
+ * @brief Claim a free reader slot by writing the current epoch into it. A remove that
+ * advances the epoch after unlinking either sees the slot or unlinked before this find started.
+ * @return the slot
+ */
+std::atomic<uint64_t>& ConcurrentBST::enter() {
+    //start at a slot picked by thread, so concurrent finds do not all fight over slot 0
+    size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+    for (size_t i = 0; ; i++) {
+        std::atomic<uint64_t>& slot = slots[(start + i) % READER_SLOTS].epoch;
+        uint64_t free = 0;
+        if (slot.load(std::memory_order_relaxed) == 0 && slot.compare_exchange_strong(free, epoch.load())) {
+            //pairs with the fence in retire: the slot is visible before any link is read
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return slot;
+        }
+        if (i % READER_SLOTS == READER_SLOTS - 1) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/**
+ * @brief Search the tree once, without any slot or version check
+ * @param query The query element to find
+ * @return true if query was found
+ */
+bool ConcurrentBST::search(const T & query) const {
+    Node* node = root.load(std::memory_order_acquire);
+    while (node != nullptr) {
+        if (node->data == query) {
+            return true;
+        }
+        node = (query < node->data) ? node->leftChild.load(std::memory_order_acquire)
+                                    : node->rightChild.load(std::memory_order_acquire);
+    }
+    return false;
+}
+
+/**
+ * @brief Find a query element without locking. A miss is retried if a node with two
+ * children was swapped for its successor during the search, since the search may have
+ * passed the old node and missed the successor's key on its way down.
+ * @param query The query element to find
+ * @return true if query exists in this BST, otherwise false
+ */
+bool ConcurrentBST::find(const T & query) {
+    std::atomic<uint64_t>& slot = enter();
+    bool found;
+    while (true) {
+        uint64_t before = version.load(std::memory_order_acquire);
+        found = search(query);
+        if (found || ((before & 1) == 0 && version.load(std::memory_order_acquire) == before)) {
+            break;
+        }
+    }
+    slot.store(0, std::memory_order_release);
+    return found;
+}
+
+/**
+ * @brief Insert a new element. The node is complete before it is linked, so a find sees all of it.
+ * @param element The new element to insert
+ * @return true if the insertion was successful, false if element is already in the BST
+ */
+bool ConcurrentBST::insert(T element) {
+    std::lock_guard<std::mutex> lock(writer);
+    std::atomic<Node*>* link = &root;
+    Node* node;
+    //writers are serialized, so relaxed loads see every earlier update
+    while ((node = link->load(std::memory_order_relaxed)) != nullptr) {
+        if (node->data == element) {
+            return false;
+        }
+        link = (element < node->data) ? &node->leftChild : &node->rightChild;
+    }
+    link->store(new Node(element), std::memory_order_release);
+    numElements.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Remove an element. Keys are never changed in place: a node with two children
+ * is replaced by a copy holding its successor's key, and the successor is unlinked after.
+ * @param element The element to remove
+ * @return true if the removal was successful, false if element was not found
+ */
+bool ConcurrentBST::remove(T element) {
+    std::lock_guard<std::mutex> lock(writer);
+    std::atomic<Node*>* link = &root;
+    Node* node;
+    while ((node = link->load(std::memory_order_relaxed)) != nullptr && node->data != element) {
+        link = (element < node->data) ? &node->leftChild : &node->rightChild;
+    }
+    if (node == nullptr) {
+        return false;
+    }
+    numElements.fetch_sub(1, std::memory_order_relaxed);
+    Node* left = node->leftChild.load(std::memory_order_relaxed);
+    Node* right = node->rightChild.load(std::memory_order_relaxed);
+
+    //at most one child: the child takes the node's place, and a find at the node still goes on below it
+    if (left == nullptr || right == nullptr) {
+        link->store(left ? left : right, std::memory_order_release);
+        retire(node, nullptr);
+        return true;
+    }
+
+    //two children: find the successor and the link that points at it
+    std::atomic<Node*>* successorLink = &node->rightChild;
+    Node* successor = right;
+    Node* next;
+    while ((next = successor->leftChild.load(std::memory_order_relaxed)) != nullptr) {
+        successorLink = &successor->leftChild;
+        successor = next;
+    }
+    Node* replacement = new Node(successor->data);
+    replacement->leftChild.store(left, std::memory_order_relaxed);
+    Node* successorRight = successor->rightChild.load(std::memory_order_relaxed);
+
+    version.fetch_add(1);
+    if (successor == right) {
+        replacement->rightChild.store(successorRight, std::memory_order_relaxed);
+        link->store(replacement, std::memory_order_release);
+    }
+    else {
+        replacement->rightChild.store(right, std::memory_order_relaxed);
+        link->store(replacement, std::memory_order_release);
+        successorLink->store(successorRight, std::memory_order_release);
+    }
+    version.fetch_add(1);
+    retire(node, successor);
+    return true;
+}
+
+/**
+ * @brief Queue removed nodes, advance the epoch and free the groups no find can reach.
+ * A find holding epoch e may have started before any unlink done in an epoch up to e,
+ * so a group removed in epoch r is freed once every held epoch is greater than r.
+ * @param first a removed node
+ * @param second another removed node, or nullptr
+ */
+void ConcurrentBST::retire(Node* first, Node* second) {
+    uint64_t removedIn = epoch.fetch_add(1);
+    if (retired.empty() || retired.back().epoch != removedIn) {
+        retired.push_back(Retired());
+        retired.back().epoch = removedIn;
+    }
+    retired.back().nodes.push_back(first);
+    numRetired++;
+    if (second != nullptr) {
+        retired.back().nodes.push_back(second);
+        numRetired++;
+    }
+
+    //pairs with the fence in enter: the unlink is visible before any slot is read
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t oldest = removedIn + 1;
+    for (Slot& slot : slots) {
+        uint64_t e = slot.epoch.load();
+        if (e != 0) {
+            oldest = std::min(oldest, e);
+        }
+    }
+    while (!retired.empty() && retired.front().epoch < oldest) {
+        for (Node* node : retired.front().nodes) {
+            delete node;
+        }
+        numRetired -= retired.front().nodes.size();
+        retired.pop_front();
+    }
+}
@@ -0,0 +1,173 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file concurrent_bst.h
+// @brief This class defines a BST whose find runs without locks
+//=======================================================
+//
+// BST is not safe to share. Its child pointers are plain pointers, so a find
+// reading one while insert stores a new node into it is a data race: nothing
+// orders the writes that fill in the node before the store that links it, and
+// a find can follow the link to a node whose key and children are not set yet.
+// Two inserts that reach the same empty child both store into it and one node
+// is lost, and numElements is a plain counter. BST also has no remove, and the
+// usual one copies the successor's key into the removed node, which a running
+// find would see change under it. ConcurrentBST keeps the same unbalanced tree
+// but publishes nodes safely and never changes a key or frees a node that a
+// find might be reading:
+//
+//  - Children are atomic pointers. insert fills in a node completely before
+//    storing it into its parent, so a find sees either nothing or the whole node.
+//  - remove unlinks a node with at most one child by pointing its parent at
+//    that child. A node with two children is replaced by a new node holding the
+//    successor's key, and then the successor is unlinked. A find that passed
+//    the old node and is looking for the successor's key can miss it during
+//    that swap, so each swap bumps a version counter around it, like a seqlock,
+//    and a find that misses retries if the version changed while it ran.
+//    Hits never retry, so a find only ever waits on a concurrent two-child remove.
+//  - Removed nodes are freed with epochs, as in PersistentBST (assign_5E): a
+//    find announces the epoch it started in, in one of a fixed set of reader
+//    slots, and a remove frees only the nodes retired before the oldest
+//    announced epoch.
+//
+// insert and remove are serialized by one mutex. Finds never take it.
+
+#ifndef ASSIGN_5_CONCURRENT_BST_H
+#define ASSIGN_5_CONCURRENT_BST_H
+
+#include "BST.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+/**
+ * Binary search tree with lock-free find, for any number of reader threads and serialized writers
+ */
+class ConcurrentBST {
+public:
+    /**
+     * A node of the tree. data never changes once the node is in the tree.
+     */
+    struct Node {
+        T data;
+        std::atomic<Node*> leftChild;
+        std::atomic<Node*> rightChild;
+
+        Node(T d) : data(d), leftChild(nullptr), rightChild(nullptr) {}
+    };
+
+    /**
+     * Number of finds that can run at the same time. One more waits for a free slot.
+     */
+    static const int READER_SLOTS = 64;
+
+    /**
+     * ConcurrentBST Constructor, which initializes an empty tree
+     */
+    ConcurrentBST();
+
+    /**
+     * ConcurrentBST Destructor. No other thread may be using the tree.
+     */
+    ~ConcurrentBST();
+
+    /**
+     * @brief Find a query element without locking. Safe to call from any thread at any time.
+     * @param query The query element to find
+     * @return true if query exists in this BST, otherwise false
+     */
+    bool find(const T & query);
+
+    /**
+     * @brief Insert a new element. Writers are serialized.
+     * @param element The new element to insert
+     * @return true if the insertion was successful, false if element is already in the BST
+     */
+    bool insert(T element);
+
+    /**
+     * @brief Remove an element. Writers are serialized.
+     * @param element The element to remove
+     * @return true if the removal was successful, false if element was not found
+     */
+    bool remove(T element);
+
+    /**
+     * @brief Return the number of elements in the BST
+     * @return The number of elements in the BST
+     */
+    unsigned int size() const;
+
+    /**
+     * @brief Return the number of removed nodes still waiting for running finds to finish
+     */
+    size_t retiredNodes() const;
+
+private:
+    /**
+     * Nodes removed by one update, with the epoch they were removed in
+     */
+    struct Retired {
+        uint64_t epoch;
+        std::vector<Node*> nodes;
+    };
+
+    /**
+     * A reader slot on its own cache line. 0 means free, otherwise the epoch of the find holding it.
+     */
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch;
+    };
+
+    std::atomic<Node*> root;
+
+    /**
+     * Odd while a node with two children is being swapped for its successor
+     */
+    std::atomic<uint64_t> version;
+
+    /**
+     * Current epoch, starting at 1. Advanced after every remove.
+     */
+    std::atomic<uint64_t> epoch;
+
+    Slot slots[READER_SLOTS];
+
+    /**
+     * Serializes insert and remove
+     */
+    std::mutex writer;
+
+    std::atomic<unsigned int> numElements;
+
+    std::deque<Retired> retired;
+
+    size_t numRetired;
+
+    /**
+     * @brief Search the tree once, without any slot or version check
+     */
+    bool search(const T & query) const;
+
+    /**
+     * @brief Claim a free reader slot holding the current epoch
+     * @return the slot
+     */
+    std::atomic<uint64_t>& enter();
+
+    /**
+     * @brief Queue removed nodes, advance the epoch and free what no find can still reach
+     * @param first a removed node
+     * @param second another removed node, or nullptr
+     */
+    void retire(Node* first, Node* second);
+
+    /**
+     * @brief Delete all nodes of a subtree
+     */
+    static void clear(Node* node);
+};
+
+#endif //ASSIGN_5_CONCURRENT_BST_H
@@ -0,0 +1,119 @@
+/**
+ * This file tests building a balanced BST from sorted and unsorted input
+ *
+ */
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <stdlib.h>
+#include <vector>
+#include "BST.h"
+#include "assert.h"
+
+using namespace std;
+
+/**
+ * @brief Check the tree holds exactly the expected elements, in order, with consistent parent links
+ * @param bst the tree
+ * @param expected the elements in ascending order
+ */
+void checkElements(BST& bst, const vector<T>& expected) {
+    assert(bst.size() == expected.size());
+    vector<T> elements;
+    if (bst.getRoot() != nullptr) {
+        assert(bst.getRoot()->parent == nullptr);
+        for (BST::Node* node = bst.getLeftMostNode(); node != nullptr; node = bst.successor(node)) {
+            if (node->leftChild != nullptr) {
+                assert(node->leftChild->parent == node);
+            }
+            if (node->rightChild != nullptr) {
+                assert(node->rightChild->parent == node);
+            }
+            elements.push_back(node->data);
+        }
+    }
+    assert(elements == expected);
+}
+
+/**
+ * @brief Check every key left of a node is smaller than it and every key right of it is not,
+ * the rule insert follows for equal keys
+ * @param node the root of the subtree
+ * @param lo the node whose right subtree holds node, or nullptr
+ * @param hi the node whose left subtree holds node, or nullptr
+ */
+void checkOrder(BST::Node* node, BST::Node* lo, BST::Node* hi) {
+    while (node != nullptr) {
+        assert(lo == nullptr || !(node->data < lo->data));
+        assert(hi == nullptr || node->data < hi->data);
+        checkOrder(node->leftChild, lo, node);
+        lo = node;
+        node = node->rightChild;
+    }
+}
+
+/**
+ * @brief Return the smallest possible height of a binary tree of n nodes
+ */
+int minimumHeight(size_t n) {
+    int height = -1;
+    while (n > 0) {
+        height++;
+        n /= 2;
+    }
+    return height;
+}
+
+int main() {
+    srand(1);
+
+    cout << "Test building from sorted input" << endl;
+    BST bst;
+    for (size_t n : {0, 1, 2, 3, 7, 8, 100, 1000}) {
+        vector<T> sorted(n);
+        for (size_t i = 0; i < n; i++) {
+            sorted[i] = 3 * i - 500;
+        }
+        bst.buildFromSorted(sorted.data(), n);
+        checkElements(bst, sorted);
+        assert(bst.height() == minimumHeight(n));
+    }
+
+    cout << "Test repeated elements are all kept" << endl;
+    T repeated[] = {1, 1, 2, 3, 3, 3, 9};
+    bst.buildFromSorted(repeated, 7);
+    checkElements(bst, {1, 1, 2, 3, 3, 3, 9});
+    checkOrder(bst.getRoot(), nullptr, nullptr);
+    vector<T> same(100000, 4);
+    bst.buildFromSorted(same.data(), same.size());
+    checkElements(bst, same);
+    checkOrder(bst.getRoot(), nullptr, nullptr);
+
+    cout << "Test building from unsorted input" << endl;
+    vector<T> nums;
+    for (int i = 0; i < 5000; i++) {
+        nums.push_back(rand() % 2000);
+    }
+    bst.buildFromUnsorted(nums.data(), nums.size());
+    multiset<T> copies(nums.begin(), nums.end());
+    checkElements(bst, vector<T>(copies.begin(), copies.end()));
+    checkOrder(bst.getRoot(), nullptr, nullptr);
+    sort(nums.begin(), nums.end());
+    nums.erase(unique(nums.begin(), nums.end()), nums.end());
+    bst.buildFromUnsorted(nums.data(), nums.size());
+    assert(bst.height() == minimumHeight(nums.size()));
+
+    cout << "Test the built tree accepts inserts" << endl;
+    nums.assign(copies.begin(), copies.end());
+    bst.buildFromSorted(nums.data(), nums.size());
+    for (T num : {-1, 5000, nums[17], nums[17], nums[1000]}) {
+        bst.insert(num);
+        copies.insert(num);
+    }
+    checkElements(bst, vector<T>(copies.begin(), copies.end()));
+    checkOrder(bst.getRoot(), nullptr, nullptr);
+    assert(bst.find(-1) && bst.find(5000) && bst.find(nums[17]) && !bst.find(2500));
+
+    cout << "Success" << endl;
+    return 0;
+}
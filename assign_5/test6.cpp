@@ -0,0 +1,117 @@
+/**
+ * This file tests the concurrent BST against std::set, and finds running while other threads insert and remove
+ *
+ */
+#include <atomic>
+#include <iostream>
+#include <pthread.h>
+#include <set>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+#include "concurrent_bst.h"
+#include "assert.h"
+
+using namespace std;
+
+/**
+ * @brief Build a tree of sorted inserts, which is a path, and destroy it
+ * @param descending nonzero to insert in descending order, making a path of left children
+ */
+void* destroyPath(void* descending) {
+    ConcurrentBST chain;
+    for (int num = 0; num < 5000; num++) {
+        chain.insert(descending ? -num : num);
+    }
+    assert(chain.size() == 5000);
+    return nullptr;
+}
+
+int main() {
+    srand(1);
+
+    cout << "Test destroying paths of left and right children on a small stack" << endl;
+    for (long descending = 0; descending <= 1; descending++) {
+        //64 KB is far less than 5000 recursive calls need
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setstacksize(&attr, 64 * 1024);
+        pthread_t thread;
+        assert(pthread_create(&thread, &attr, destroyPath, (void*)descending) == 0);
+        pthread_join(thread, nullptr);
+        pthread_attr_destroy(&attr);
+    }
+
+    cout << "Test random inserts and removes against std::set" << endl;
+    ConcurrentBST bst;
+    set<T> expected;
+    for (int round = 0; round < 20000; round++) {
+        T num = rand() % 2000;
+        if (rand() % 3 == 0) {
+            assert(bst.remove(num) == (expected.erase(num) == 1));
+        } else {
+            assert(bst.insert(num) == expected.insert(num).second);
+        }
+        assert(bst.find(num) == (expected.count(num) == 1));
+    }
+    assert(bst.size() == expected.size());
+    for (T num = -10; num < 2010; num++) {
+        assert(bst.find(num) == (expected.count(num) == 1));
+    }
+
+    cout << "Test removed nodes are freed" << endl;
+    for (T num : expected) {
+        assert(bst.remove(num));
+    }
+    assert(bst.size() == 0 && bst.retiredNodes() == 0);
+
+    cout << "Test finds while writers update" << endl;
+    //keys that are 0 mod 4 stay in the tree and keys that are 1 mod 4 never enter it, while
+    //the writers insert and remove keys that are 2 or 3 mod 4. Those sit between the stable
+    //keys, so the writers remove nodes with two children on the stable keys' search paths and
+    //move stable keys into replacement nodes.
+    ConcurrentBST shared;
+    const int n = 4000;
+    vector<T> stable;
+    for (int i = 0; i < 2 * n; i++) {
+        T num = rand() % (4 * n);
+        if (num % 4 != 1 && shared.insert(num) && num % 4 == 0) {
+            stable.push_back(num);
+        }
+    }
+    atomic<bool> done(false);
+    vector<thread> threads;
+    for (int w = 0; w < 2; w++) {
+        threads.push_back(thread([&shared, &done, w]() {
+            unsigned int seed = w + 1;
+            while (!done.load()) {
+                T num = 4 * (rand_r(&seed) % n) + 2 + w;
+                if (rand_r(&seed) % 2) {
+                    shared.insert(num);
+                } else {
+                    shared.remove(num);
+                }
+            }
+        }));
+    }
+    for (int r = 0; r < 4; r++) {
+        threads.push_back(thread([&shared, &stable, r]() {
+            for (int round = 0; round < 20; round++) {
+                for (size_t i = r; i < stable.size(); i += 4) {
+                    assert(shared.find(stable[i]));
+                    assert(!shared.find(stable[i] + 1));
+                    assert(!shared.find(stable[i] - 3));
+                }
+            }
+        }));
+    }
+    for (size_t i = 2; i < threads.size(); i++) {
+        threads[i].join();
+    }
+    done.store(true);
+    threads[0].join();
+    threads[1].join();
+
+    cout << "Success" << endl;
+    return 0;
+}
@@ -11,6 +11,10 @@
 //=======================================================
 
 #include "BST.h"
+#include "frozen_bst.h"
+#include <algorithm>
+#include <future>
+#include <thread>
 #include <vector>
 #include <iostream>
 
@@ -61,6 +65,62 @@ void BST::clear(Node* node) {
     }
     delete node;
 }
+/**
+ * @brief Replace the contents of this BST with a height-balanced tree of sorted elements in O(n)
+ * @param sorted elements in ascending order. Repeated elements are only stored once.
+ * @param n number of elements
+ */
+void BST::buildFromSorted(const T* sorted, size_t n) {
+    clear();
+    //the middle-element build needs distinct elements, so drop repeats into a copy if there are any
+    std::vector<T> distinct;
+    for(size_t i = 1; i < n; i++){
+        if(sorted[i] == sorted[i - 1]){
+            distinct.assign(sorted, sorted + n);
+            distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+            sorted = distinct.data();
+            n = distinct.size();
+            break;
+        }
+    }
+    root = buildSubtree(sorted, 0, n, nullptr);
+    numElements = n;
+}
+
+/**
+ * @brief Replace the contents of this BST with a height-balanced tree of the elements
+ * @param elements elements in any order. Repeated elements are only stored once.
+ * @param n number of elements
+ */
+void BST::buildFromUnsorted(const T* elements, size_t n) {
+    std::vector<T> sorted(elements, elements + n);
+    std::sort(sorted.begin(), sorted.end());
+    buildFromSorted(sorted.data(), sorted.size());
+}
+
+/**
+ * @brief Build a balanced subtree from sorted[lo, hi), taking the middle element as its root.
+ * The two halves differ in size by at most one, so their heights differ by at most one
+ * and every node satisfies the AVL property without any rotation.
+ * @param sorted elements in strictly ascending order
+ * @param lo index of the first element of the subtree
+ * @param hi index past the last element of the subtree
+ * @param parent the parent of the subtree root
+ * @return the root of the subtree, nullptr if lo == hi
+ */
+BST::Node *BST::buildSubtree(const T* sorted, size_t lo, size_t hi, Node* parent) {
+    if(lo == hi){
+        return nullptr;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    Node* node = new Node(sorted[mid]);
+    node->parent = parent;
+    node->leftChild = buildSubtree(sorted, lo, mid, node);
+    node->rightChild = buildSubtree(sorted, mid + 1, hi, node);
+    updateHeight(node);
+    return node;
+}
+
 /**
  * @brief Find a query element in this BST
  * @param query The query element to find
@@ -97,19 +157,13 @@ int BST::height() const {
 }
 
 /**
- * @brief Return the height of the BST starting at input node. input node is at height 0
+ * @brief Return the height of the BST starting at input node. input node is at height 0.
+ * Every node keeps the height of its subtree up to date, so nothing is recomputed.
  * @param node a pointer to a node in the BST
  * @return The height of the BST starting at node
  */
 int BST::height(Node* node) const{
-    if (node == nullptr) {
-        return -1;
-    }
-    //recursively call height on left and right subtrees
-    int leftHeight = height(node->leftChild);
-    int rightHeight = height(node->rightChild);
-    //return the max size of left and right subtrees + 1
-    return 1 + std::max(leftHeight, rightHeight);
+    return (node == nullptr) ? -1 : node->height;
 }
 
 /**
@@ -159,6 +213,117 @@ void BST::printPostorder(Node* node) {
     }
 }
 
+/**
+ * @brief Return an iterator to the smallest element
+ * @return the first iterator, equal to end() if the BST is empty
+ */
+BST::Iterator BST::begin() const {
+    Node* curNode = root;
+    while(curNode != nullptr && curNode->leftChild != nullptr){
+        curNode = curNode->leftChild;
+    }
+    return Iterator(curNode);
+}
+
+/**
+ * @brief Find the first element that is not less than key
+ * @param key the key to search for
+ * @return iterator to the element, end() if every element is less than key
+ */
+BST::Iterator BST::lower_bound(const T &key) const {
+    Node* found = nullptr;
+    Node* curNode = root;
+    while(curNode != nullptr){
+        //a node not less than key is a candidate, but a smaller one may be on its left
+        if(curNode->data < key){
+            curNode = curNode->rightChild;
+        }
+        else{
+            found = curNode;
+            curNode = curNode->leftChild;
+        }
+    }
+    return Iterator(found);
+}
+
+/**
+ * @brief Count the elements smaller than key in O(log n) using subtree sizes
+ * @param key the key to rank, which does not have to be in the BST
+ * @return the number of elements less than key
+ */
+unsigned int BST::rank(const T &key) const {
+    unsigned int count = 0;
+    Node* curNode = root;
+    while(curNode != nullptr){
+        //going right passes the node and its whole left subtree, all smaller than key
+        if(curNode->data < key){
+            count += 1 + (curNode->leftChild ? curNode->leftChild->size : 0);
+            curNode = curNode->rightChild;
+        }
+        else{
+            curNode = curNode->leftChild;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Count the elements not greater than key
+ * @param key the key to rank
+ * @return the number of elements less than or equal to key
+ */
+unsigned int BST::rankUpper(const T &key) const {
+    unsigned int count = 0;
+    Node* curNode = root;
+    while(curNode != nullptr){
+        if(key < curNode->data){
+            curNode = curNode->leftChild;
+        }
+        else{
+            count += 1 + (curNode->leftChild ? curNode->leftChild->size : 0);
+            curNode = curNode->rightChild;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Find the k-th smallest element in O(log n) using subtree sizes
+ * @param k 0-based position in sorted order
+ * @return the node holding the k-th smallest element, nullptr if k >= size()
+ */
+BST::Node *BST::select(unsigned int k) const {
+    Node* curNode = root;
+    while(curNode != nullptr){
+        unsigned int leftSize = curNode->leftChild ? curNode->leftChild->size : 0;
+        if(k < leftSize){
+            curNode = curNode->leftChild;
+        }
+        else if(k == leftSize){
+            return curNode;
+        }
+        else{
+            //skip the left subtree and the node itself
+            k -= leftSize + 1;
+            curNode = curNode->rightChild;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Count the elements in the closed range [lo, hi] in O(log n)
+ * @param lo lower bound of the range
+ * @param hi upper bound of the range
+ * @return the number of elements e with lo <= e <= hi, 0 if hi < lo
+ */
+unsigned int BST::countRange(const T &lo, const T &hi) const {
+    if(hi < lo){
+        return 0;
+    }
+    return rankUpper(hi) - rank(lo);
+}
+
 /**
  * @brief Return pointer to the left-most node in this BST
  * @return The left-most node in this BST
@@ -214,6 +379,8 @@ bool BST::insert(T element) {
         // Step 1 - do a regular binary search tree insert.
         Node* currentNode = root;
         while (currentNode) {
+            // The new node ends up in the subtree of every node on the way down
+            currentNode->size++;
             // Choose to go left or right
             if (element < currentNode->data) {
                 // Go left. If left child is null, insert the new
@@ -244,14 +411,98 @@ bool BST::insert(T element) {
         }
 
         // Step 2 - Rebalance along a path from the new node's parent up
-        // to the root.
-        node = node->parent;
-        while (node) {
-            rebalance(node);
-            node = node->parent;
+        // to the first subtree whose height did not change. The parent's
+        // stored height is still the one from before the insert.
+        retrace(node->parent, node->parent->height);
+    }
+    numElements++;
+    return true;
+}
+
+/**
+ * @brief Climb from a finger to the lowest node visited whose subtree holds the place of key.
+ * Going up from x to its parent p, p bounds x's subtree from above if x is a left child
+ * and from below if x is a right child. Only a bound on the side of key from the finger can
+ * stop the climb: key strictly inside it means the place is under start; otherwise the
+ * place is at or beyond p, so p becomes start.
+ * @param finger a node of this BST, or nullptr
+ * @param key the key to search for
+ * @return the node to start going down from, root if finger is nullptr
+ */
+BST::Node *BST::fingerStart(Node *finger, const T &key) const {
+    if (finger == nullptr) {
+        return root;
+    }
+    //equal keys go right, as in insert
+    bool right = !(key < finger->data);
+    Node* start = finger;
+    Node* parent;
+    for (Node* node = finger; (parent = node->parent) != nullptr; node = parent) {
+        //the side and the comparison are unpredictable, so they pick start without a branch
+        //and the only branch, out of the loop, is taken once
+        bool bound = (parent->leftChild == node) == right;
+        bool inside = right ? key < parent->data : parent->data < key;
+        if (bound && inside) {
+            break;
         }
+        start = bound ? parent : start;
+    }
+    return start;
+}
+
+/**
+ * @brief Find a query element, starting from a finger
+ * @param query The query element to find
+ * @param finger a node of this BST or nullptr to start at the root. Set to the node holding
+ * query, or to the last node visited if query is not in the BST.
+ * @return true if query exists in this BST, otherwise false
+ */
+bool BST::find(const T &query, Node *&finger) const {
+    Node* curNode = fingerStart(finger, query);
+    Node* last = finger;
+    bool found = false;
+    while (curNode != nullptr && !found) {
+        last = curNode;
+        found = curNode->data == query;
+        curNode = query < curNode->data ? curNode->leftChild : curNode->rightChild;
     }
+    finger = last;
+    return found;
+}
+
+/**
+ * @brief Insert a new element, starting the search for its place from a finger
+ * @param element The new element to insert
+ * @param finger a node of this BST or nullptr to start at the root. Set to the new node.
+ * @return true
+ */
+bool BST::insert(T element, Node *&finger) {
+    Node* parent = fingerStart(finger, element);
+    if (parent == nullptr) {
+        insert(element);
+        finger = root;
+        return true;
+    }
+    // go down from the start to the empty link where element belongs
+    Node* next;
+    while ((next = element < parent->data ? parent->leftChild : parent->rightChild) != nullptr) {
+        parent = next;
+    }
+    Node* node = new Node(element);
+    node->parent = parent;
+    if (element < parent->data) {
+        parent->leftChild = node;
+    }
+    else {
+        parent->rightChild = node;
+    }
+    // the new node is in the subtree of every ancestor, including those above the start
+    for (Node* ancestor = parent; ancestor; ancestor = ancestor->parent) {
+        ancestor->size++;
+    }
+    retrace(parent, parent->height);
     numElements++;
+    finger = node;
     return true;
 }
 
@@ -281,9 +532,6 @@ bool BST::remove(T element) {
 }
 
 bool BST::removeNode(Node* node){
-    // Parent needed for rebalancing.
-    Node* parent = node->parent;
-
     // Case 1: Internal node with 2 children
     if (node->leftChild && node->rightChild) {
         // Find successor
@@ -292,18 +540,45 @@ bool BST::removeNode(Node* node){
             successorNode = successorNode->leftChild;
         }
 
-        // Copy the value from the node
-        node->data = successorNode->data;
-
-        // Recursively remove successor
-        removeNode(successorNode);
-
-        // Nothing left to do since the recursive call will have rebalanced
+        // Take the successor node out of the tree, rebalancing above it,
+        // then move it into node's place. The node is moved rather than its data,
+        // so a finger on the successor still points at the successor's key.
+        unlinkNode(successorNode);
+        successorNode->leftChild = node->leftChild;
+        successorNode->rightChild = node->rightChild;
+        if (successorNode->leftChild) {
+            successorNode->leftChild->parent = successorNode;
+        }
+        if (successorNode->rightChild) {
+            successorNode->rightChild->parent = successorNode;
+        }
+        successorNode->parent = node->parent;
+        successorNode->height = node->height;
+        successorNode->size = node->size;
+        if (node->parent == nullptr) {
+            root = successorNode;
+        }
+        else if (node->parent->leftChild == node) {
+            node->parent->leftChild = successorNode;
+        }
+        else {
+            node->parent->rightChild = successorNode;
+        }
+        delete node;
         return true;
     }
 
-    // Case 2: Root node (with 1 or 0 children)
-    else if (node == root) {
+    unlinkNode(node);
+    delete node;
+    return true;
+}
+
+void BST::unlinkNode(Node* node){
+    // Parent needed for rebalancing.
+    Node* parent = node->parent;
+
+    // Root node (with 1 or 0 children)
+    if (node == root) {
         if (node->leftChild) {
             root = node->leftChild;
         }
@@ -314,51 +589,94 @@ bool BST::removeNode(Node* node){
         if (root) {
             root->parent = nullptr;
         }
+        return;
+    }
 
-        delete node;
-        return true;
+    // parent's height is updated by replaceChild below, so remember the old one for retracing
+    int parentHeight = parent->height;
+
+    // every ancestor loses one node from its subtree
+    for (Node* ancestor = parent; ancestor; ancestor = ancestor->parent) {
+        ancestor->size--;
     }
 
-    // Case 3: Internal with left child only
-    else if (node->leftChild) {
+    // Internal with left child only
+    if (node->leftChild) {
         replaceChild(node, node->leftChild, parent);
     }
 
-    // Case 4: Internal with right child only OR leaf
+    // Internal with right child only OR leaf
     else {
         replaceChild(node, node->rightChild, parent);
     }
 
-    // nodeToRemove is removed from the tree and can be deleted
-    delete node;
-
     // Anything that was below nodeToRemove that has persisted is already 
     // correctly balanced, but ancestors of nodeToRemove may need rebalancing.
-    Node* nodeToRebalance = parent;
-    while (nodeToRebalance) {
-    rebalance(nodeToRebalance);         
-        nodeToRebalance = nodeToRebalance->parent;
-    }
-    return true;
+    retrace(parent, parentHeight);
 }
 
 /**
- * Implement the rebalance() function correctly
+ * @brief Rebalance the subtree rooted at node
+ * @param node The root of the subtree to rebalance
+ * @return the root of the subtree after rebalancing
  */
-void BST::rebalance(Node *node) {
+BST::Node *BST::rebalance(Node *node) {
+    counters.visits++;
     updateHeight(node);
     if(balanceFactor(node) == -2){
         if(balanceFactor(node->rightChild) == 1){
             rotateRight(node->rightChild);
         }
         rotateLeft(node);
+        return node->parent;
     }
     else if(balanceFactor(node) == 2){
         if(balanceFactor(node->leftChild) == -1){
             rotateLeft(node->leftChild);
         }
         rotateRight(node);
+        return node->parent;
     }
+    return node;
+}
+
+/**
+ * @brief Rebalance the ancestors of a changed subtree, stopping at the first unchanged height
+ * @param node the lowest node whose subtree changed
+ * @param oldHeight the height stored in node before the change
+ */
+void BST::retrace(Node *node, int oldHeight) {
+    while (node) {
+        // a rotation at node recomputes the parent's height part way through,
+        // so the parent's old height is taken first
+        Node* parent = node->parent;
+        int parentHeight = height(parent);
+        node = rebalance(node);
+        // after an insert, a rotation always restores the old height; after a remove it may not
+        if (node->height == oldHeight) {
+            if (parent) {
+                updateHeight(parent);
+            }
+            return;
+        }
+        node = parent;
+        oldHeight = parentHeight;
+    }
+}
+
+/**
+ * @brief Return the rebalancing counters since construction or the last resetStats()
+ * @return the counters
+ */
+const BST::Stats &BST::stats() const {
+    return counters;
+}
+
+/**
+ * @brief Set the rebalancing counters back to zero
+ */
+void BST::resetStats() {
+    counters = Stats();
 }
 
 /**
@@ -387,6 +705,10 @@ void BST::rotateLeft(Node *node) {
 
     // Step 3 - reattach rightLeftChild as the right child of node.
     setChild(false, rightLeftChild, node);
+
+    // node's height changed in step 3, so the new subtree root's height is recomputed from it.
+    updateHeight(node->parent);
+    counters.rotations++;
 }
 
 /**
@@ -415,6 +737,10 @@ void BST::rotateRight(Node *node) {
 
     // Step 3 - reattach leftRightChild as the right child of node.
     setChild(true, leftRightChild, node);
+
+    // node's height changed in step 3, so the new subtree root's height is recomputed from it.
+    updateHeight(node->parent);
+    counters.rotations++;
 }
 
 // Compute the balance factor of a node
@@ -443,13 +769,17 @@ void BST::printBalanceFactors(Node *node) {
 void BST::updateHeight(Node* node){
     int leftHeight = -1;
     int rightHeight = -1;
+    unsigned int size = 1;
     if(node->leftChild){
         leftHeight = node->leftChild->height;
+        size += node->leftChild->size;
     }
     if(node->rightChild){
         rightHeight = node->rightChild->height;
+        size += node->rightChild->size;
     }
     node->height = 1 + std::max(leftHeight, rightHeight);
+    node->size = size;
 }
 
 bool BST::setChild(bool left, Node* child, Node* node) {
@@ -483,4 +813,468 @@ bool BST::replaceChild(Node* currentChild, Node* newChild, Node* node){
     // If neither of the above cases applied, then the new child
     // could not be attached to this node.
     return false;
-}
\ No newline at end of file
+}
+
+// Smallest input, in nodes, for which a set operation hands half of its work to another task
+static const unsigned int PARALLEL_GRAIN = 8192;
+
+/**
+ * @brief Return the number of tasks a set operation may use
+ * @param threads the number asked for, 0 for the number of hardware threads
+ */
+static unsigned int taskCount(unsigned int threads) {
+    if(threads == 0){
+        threads = std::thread::hardware_concurrency();
+    }
+    return std::max(threads, 1u);
+}
+
+/**
+ * @brief Make left and right the children of node and update node's height and size
+ * @return node
+ */
+BST::Node *BST::link(Node *node, Node *left, Node *right) {
+    node->leftChild = left;
+    node->rightChild = right;
+    if(left){
+        left->parent = node;
+    }
+    if(right){
+        right->parent = node;
+    }
+    updateHeight(node);
+    return node;
+}
+
+/**
+ * @brief Rotate a detached subtree to the left
+ * @param node the subtree root
+ * @return the new subtree root
+ */
+BST::Node *BST::rotateSubtreeLeft(Node *node) {
+    Node* rightChild = node->rightChild;
+    link(node, node->leftChild, rightChild->leftChild);
+    return link(rightChild, node, rightChild->rightChild);
+}
+
+/**
+ * @brief Rotate a detached subtree to the right
+ * @param node the subtree root
+ * @return the new subtree root
+ */
+BST::Node *BST::rotateSubtreeRight(Node *node) {
+    Node* leftChild = node->leftChild;
+    link(node, leftChild->rightChild, node->rightChild);
+    return link(leftChild, leftChild->leftChild, node);
+}
+
+/**
+ * @brief Restore the AVL property at the root of a detached subtree whose children differ in height by at most 2
+ * @param node the subtree root
+ * @return the new subtree root
+ */
+BST::Node *BST::balanceSubtree(Node *node) {
+    updateHeight(node);
+    int balance = balanceFactor(node);
+    if(balance > 1){
+        if(balanceFactor(node->leftChild) < 0){
+            link(node, rotateSubtreeLeft(node->leftChild), node->rightChild);
+        }
+        return rotateSubtreeRight(node);
+    }
+    if(balance < -1){
+        if(balanceFactor(node->rightChild) > 0){
+            link(node, node->leftChild, rotateSubtreeRight(node->rightChild));
+        }
+        return rotateSubtreeLeft(node);
+    }
+    return node;
+}
+
+/**
+ * @brief Join two AVL subtrees and a middle node, all keys of left < middle < all keys of right.
+ * Walks down the spine of the taller subtree to a subtree about as tall as the other one,
+ * joins there, and rebalances on the way back up, so it takes O(|height(left) - height(right)|) time.
+ * @return the root of the joined subtree
+ */
+BST::Node *BST::joinSubtrees(Node *left, Node *middle, Node *right) {
+    int leftHeight = height(left);
+    int rightHeight = height(right);
+    if(leftHeight > rightHeight + 1){
+        return balanceSubtree(link(left, left->leftChild, joinSubtrees(left->rightChild, middle, right)));
+    }
+    if(rightHeight > leftHeight + 1){
+        return balanceSubtree(link(right, joinSubtrees(left, middle, right->leftChild), right->rightChild));
+    }
+    return link(middle, left, right);
+}
+
+/**
+ * @brief Join two AVL subtrees, all keys of left < all keys of right
+ * @return the root of the joined subtree
+ */
+BST::Node *BST::joinSubtrees(Node *left, Node *right) {
+    if(right == nullptr){
+        return left;
+    }
+    Node* smallest;
+    right = removeSmallest(right, smallest);
+    return joinSubtrees(left, smallest, right);
+}
+
+/**
+ * @brief Unlink the smallest node of a subtree
+ * @param node the subtree root
+ * @param smallest gets the smallest node, detached
+ * @return the root of the remaining subtree
+ */
+BST::Node *BST::removeSmallest(Node *node, Node *&smallest) {
+    if(node->leftChild == nullptr){
+        smallest = node;
+        return node->rightChild;
+    }
+    return balanceSubtree(link(node, removeSmallest(node->leftChild, smallest), node->rightChild));
+}
+
+/**
+ * @brief Split a subtree around key. The nodes on the search path are joined back onto
+ * the side they belong to, so the cost is O(log n).
+ * @param node the subtree root
+ * @param key the key to split at
+ * @param less gets the subtree of keys smaller than key
+ * @param greater gets the subtree of keys greater than key
+ * @return the node holding key, detached, or nullptr if key is not in the subtree
+ */
+BST::Node *BST::splitSubtree(Node *node, const T &key, Node *&less, Node *&greater) {
+    if(node == nullptr){
+        less = greater = nullptr;
+        return nullptr;
+    }
+    Node* leftChild = node->leftChild;
+    Node* rightChild = node->rightChild;
+    if(key < node->data){
+        Node* found = splitSubtree(leftChild, key, less, greater);
+        greater = joinSubtrees(greater, node, rightChild);
+        return found;
+    }
+    if(node->data < key){
+        Node* found = splitSubtree(rightChild, key, less, greater);
+        less = joinSubtrees(leftChild, node, less);
+        return found;
+    }
+    less = leftChild;
+    greater = rightChild;
+    return node;
+}
+
+/**
+ * @brief Union of two subtrees. b is split around the root of a, the two halves are
+ * combined recursively (in parallel while tasks allow), and joined back with a's root.
+ * @return the root of the result
+ */
+BST::Node *BST::unionSubtrees(Node *a, Node *b, unsigned int tasks) {
+    if(a == nullptr){
+        return b;
+    }
+    if(b == nullptr){
+        return a;
+    }
+    Node *less, *greater;
+    Node* duplicate = splitSubtree(b, a->data, less, greater);
+    delete duplicate;
+    Node* aLeft = a->leftChild;
+    Node* aRight = a->rightChild;
+    Node *left, *right;
+    if(tasks > 1 && a->size + b->size >= PARALLEL_GRAIN){
+        std::future<Node*> leftTask = std::async(std::launch::async, &BST::unionSubtrees, this, aLeft, less, tasks / 2);
+        right = unionSubtrees(aRight, greater, tasks - tasks / 2);
+        left = leftTask.get();
+    }
+    else{
+        left = unionSubtrees(aLeft, less, 1);
+        right = unionSubtrees(aRight, greater, 1);
+    }
+    return joinSubtrees(left, a, right);
+}
+
+/**
+ * @brief Intersection of two subtrees. b is split around the root of a, and a's root
+ * is kept only if b held the same key.
+ * @return the root of the result
+ */
+BST::Node *BST::intersectSubtrees(Node *a, Node *b, unsigned int tasks) {
+    if(a == nullptr || b == nullptr){
+        clear(a);
+        clear(b);
+        return nullptr;
+    }
+    Node *less, *greater;
+    Node* match = splitSubtree(b, a->data, less, greater);
+    Node* aLeft = a->leftChild;
+    Node* aRight = a->rightChild;
+    Node *left, *right;
+    if(tasks > 1 && a->size + b->size >= PARALLEL_GRAIN){
+        std::future<Node*> leftTask = std::async(std::launch::async, &BST::intersectSubtrees, this, aLeft, less, tasks / 2);
+        right = intersectSubtrees(aRight, greater, tasks - tasks / 2);
+        left = leftTask.get();
+    }
+    else{
+        left = intersectSubtrees(aLeft, less, 1);
+        right = intersectSubtrees(aRight, greater, 1);
+    }
+    if(match != nullptr){
+        delete match;
+        return joinSubtrees(left, a, right);
+    }
+    delete a;
+    return joinSubtrees(left, right);
+}
+
+/**
+ * @brief Difference of two subtrees, the keys of a that are not in b. a is split around
+ * the root of b, whose key is dropped from the result.
+ * @return the root of the result
+ */
+BST::Node *BST::differenceSubtrees(Node *a, Node *b, unsigned int tasks) {
+    if(a == nullptr || b == nullptr){
+        clear(b);
+        return a;
+    }
+    Node *less, *greater;
+    Node* match = splitSubtree(a, b->data, less, greater);
+    delete match;
+    Node* bLeft = b->leftChild;
+    Node* bRight = b->rightChild;
+    Node *left, *right;
+    if(tasks > 1 && b->size + (less ? less->size : 0) + (greater ? greater->size : 0) >= PARALLEL_GRAIN){
+        std::future<Node*> leftTask = std::async(std::launch::async, &BST::differenceSubtrees, this, less, bLeft, tasks / 2);
+        right = differenceSubtrees(greater, bRight, tasks - tasks / 2);
+        left = leftTask.get();
+    }
+    else{
+        left = differenceSubtrees(less, bLeft, 1);
+        right = differenceSubtrees(greater, bRight, 1);
+    }
+    delete b;
+    return joinSubtrees(left, right);
+}
+
+/**
+ * @brief Make node the root of this BST, after a set operation
+ * @param node the new root
+ */
+void BST::setRoot(Node *node) {
+    root = node;
+    if(root){
+        root->parent = nullptr;
+    }
+    numElements = root ? root->size : 0;
+}
+
+/**
+ * @brief Move the elements of this BST into two BSTs around key. This BST is left empty.
+ * @param key the key to split at
+ * @param less gets the elements smaller than key. Its old contents are cleared.
+ * @param greater gets the elements greater than key. Its old contents are cleared.
+ * @return true if key was in this BST. It goes into neither half.
+ */
+bool BST::split(const T &key, BST &less, BST &greater) {
+    Node *lessRoot, *greaterRoot;
+    Node* found = splitSubtree(root, key, lessRoot, greaterRoot);
+    delete found;
+    setRoot(nullptr);
+    less.clear();
+    less.setRoot(lessRoot);
+    greater.clear();
+    greater.setRoot(greaterRoot);
+    return found != nullptr;
+}
+
+/**
+ * @brief Append the elements of greater, which must all be larger than the elements of this BST.
+ * greater is left empty.
+ * @param greater the BST to append
+ */
+void BST::join(BST &greater) {
+    if(&greater == this){
+        return;
+    }
+    setRoot(joinSubtrees(root, greater.root));
+    greater.setRoot(nullptr);
+}
+
+/**
+ * @brief Add every element of other to this BST. other is left empty.
+ * @param other the other set
+ * @param threads maximum number of parallel tasks, 0 for the number of hardware threads
+ */
+void BST::unionWith(BST &other, unsigned int threads) {
+    if(&other == this){
+        return;
+    }
+    setRoot(unionSubtrees(root, other.root, taskCount(threads)));
+    other.setRoot(nullptr);
+}
+
+/**
+ * @brief Keep only the elements that are also in other. other is left empty.
+ * @param other the other set
+ * @param threads maximum number of parallel tasks, 0 for the number of hardware threads
+ */
+void BST::intersectWith(BST &other, unsigned int threads) {
+    if(&other == this){
+        return;
+    }
+    setRoot(intersectSubtrees(root, other.root, taskCount(threads)));
+    other.setRoot(nullptr);
+}
+
+/**
+ * @brief Remove every element that is in other. other is left empty.
+ * @param other the other set
+ * @param threads maximum number of parallel tasks, 0 for the number of hardware threads
+ */
+void BST::differenceWith(BST &other, unsigned int threads) {
+    if(&other == this){
+        clear();
+        return;
+    }
+    setRoot(differenceSubtrees(root, other.root, taskCount(threads)));
+    other.setRoot(nullptr);
+}
+
+// A batch of at least 1/BATCH_REBUILD_RATIO of the tree size is merged by rebuilding the whole tree
+static const size_t BATCH_REBUILD_RATIO = 8;
+
+/**
+ * @brief Return the distinct elements of a batch in ascending order
+ * @param elements the batch, in any order
+ * @param n number of elements
+ */
+static std::vector<T> sortedBatch(const T *elements, size_t n) {
+    std::vector<T> sorted(elements, elements + n);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    return sorted;
+}
+
+/**
+ * @brief Append the nodes of a subtree to a vector in order
+ * @param node the subtree root
+ * @param out gets the nodes
+ */
+void BST::collectNodes(Node *node, std::vector<Node*> &out) {
+    while(node != nullptr){
+        collectNodes(node->leftChild, out);
+        out.push_back(node);
+        node = node->rightChild;
+    }
+}
+
+/**
+ * @brief Link nodes[lo, hi) into a balanced subtree, taking the middle node as its root.
+ * Same shape as buildSubtree, but it reuses existing nodes.
+ * @param nodes nodes in ascending order of their data
+ * @param lo index of the first node of the subtree
+ * @param hi index past the last node of the subtree
+ * @return the root of the subtree, nullptr if lo == hi
+ */
+BST::Node *BST::linkBalanced(Node **nodes, size_t lo, size_t hi) {
+    if(lo == hi){
+        return nullptr;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    return link(nodes[mid], linkBalanced(nodes, lo, mid), linkBalanced(nodes, mid + 1, hi));
+}
+
+/**
+ * @brief Insert a batch of elements in one pass. A small batch is built into a balanced
+ * subtree and merged in with a union. A large one is merged with the in-order list of
+ * nodes and the tree is relinked from the merged list in O(n + m), reusing every node.
+ * @param elements the elements to insert, in any order
+ * @param n number of elements
+ * @return the number of elements added to the tree
+ */
+size_t BST::insertBatch(const T *elements, size_t n) {
+    std::vector<T> sorted = sortedBatch(elements, n);
+    size_t oldSize = numElements;
+    if(sorted.size() * BATCH_REBUILD_RATIO < numElements){
+        setRoot(unionSubtrees(root, buildSubtree(sorted.data(), 0, sorted.size(), nullptr), 1));
+        return numElements - oldSize;
+    }
+    std::vector<Node*> nodes;
+    nodes.reserve(numElements);
+    collectNodes(root, nodes);
+    std::vector<Node*> merged;
+    merged.reserve(nodes.size() + sorted.size());
+    size_t i = 0;
+    for(T element : sorted){
+        while(i < nodes.size() && nodes[i]->data < element){
+            merged.push_back(nodes[i++]);
+        }
+        if(i == nodes.size() || element < nodes[i]->data){
+            merged.push_back(new Node(element));
+        }
+    }
+    merged.insert(merged.end(), nodes.begin() + i, nodes.end());
+    setRoot(linkBalanced(merged.data(), 0, merged.size()));
+    return numElements - oldSize;
+}
+
+/**
+ * @brief Remove a batch of elements in one pass. A small batch is merged out with a
+ * difference, a large one by relinking the remaining nodes as for insertBatch. Both
+ * remove one copy per distinct element, like remove.
+ * @param elements the elements to remove, in any order
+ * @param n number of elements
+ * @return the number of elements removed from the tree
+ */
+size_t BST::removeBatch(const T *elements, size_t n) {
+    std::vector<T> sorted = sortedBatch(elements, n);
+    size_t oldSize = numElements;
+    if(sorted.size() * BATCH_REBUILD_RATIO < numElements){
+        setRoot(differenceSubtrees(root, buildSubtree(sorted.data(), 0, sorted.size(), nullptr), 1));
+        return oldSize - numElements;
+    }
+    std::vector<Node*> nodes;
+    nodes.reserve(numElements);
+    collectNodes(root, nodes);
+    size_t kept = 0;
+    size_t j = 0;
+    for(Node* node : nodes){
+        while(j < sorted.size() && sorted[j] < node->data){
+            j++;
+        }
+        if(j < sorted.size() && sorted[j] == node->data){
+            delete node;
+            j++;
+        }
+        else{
+            nodes[kept++] = node;
+        }
+    }
+    setRoot(linkBalanced(nodes.data(), 0, kept));
+    return oldSize - numElements;
+}
+
+/**
+ * @brief Export the elements into a read-only array in Eytzinger order
+ * @return the frozen copy
+ */
+FrozenBST BST::freeze() const {
+    std::vector<T> sorted(begin(), end());
+    FrozenBST frozen;
+    frozen.build(sorted.data(), sorted.size(), FrozenBST::EYTZINGER);
+    return frozen;
+}
+
+/**
+ * @brief Export the elements into a read-only array in van Emde Boas order
+ * @return the frozen copy
+ */
+FrozenBST BST::freezeVanEmdeBoas() const {
+    std::vector<T> sorted(begin(), end());
+    FrozenBST frozen;
+    frozen.build(sorted.data(), sorted.size(), FrozenBST::VAN_EMDE_BOAS);
+    return frozen;
+}
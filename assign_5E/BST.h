@@ -12,10 +12,16 @@
 #ifndef ASSIGN_5E_BST_H
 #define ASSIGN_5E_BST_H
 
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
 // T: element data type
 // int for node element typ now, but can be changed to any data type.
 typedef int T;
 
+class FrozenBST;
+
 /**
  * Class to implement a Binary Search Tree (BST)
  */
@@ -53,15 +59,73 @@ public:
          */
         int height;
 
+        /**
+         * The number of nodes in the subtree rooted at this node, including itself
+         */
+        unsigned int size;
+
         /**
          * Node constructor, which initializes everything
          */
         Node(T d) : data(d), leftChild(nullptr), rightChild(nullptr), parent(nullptr)
         {
             height = 0;
+            size = 1;
         }
     };
 
+    /**
+     * Read-only iterator over the elements in ascending order.
+     * Moving to the next element follows child and parent pointers,
+     * so iterating uses no recursion, no stack and no allocation.
+     */
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        /**
+         * @brief Iterator constructor
+         * @param node the node to start at, nullptr for the end
+         */
+        Iterator(Node *node = nullptr) : node(node) {}
+
+        const T &operator*() const { return node->data; }
+        const T *operator->() const { return &node->data; }
+
+        /**
+         * @brief Move to the next element in ascending order
+         */
+        Iterator &operator++()
+        {
+            node = nextInorder(node);
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator old = *this;
+            node = nextInorder(node);
+            return old;
+        }
+
+        bool operator==(const Iterator &other) const { return node == other.node; }
+        bool operator!=(const Iterator &other) const { return node != other.node; }
+
+        /**
+         * @brief Return the node the iterator is at
+         * @return the node, nullptr at the end
+         */
+        Node *getNode() const { return node; }
+
+    private:
+        Node *node;
+    };
+
     /**
      * BST Constructor, which should initialize an empty BST
      */
@@ -72,6 +136,23 @@ public:
      */
     ~BST();
 
+    /**
+     * @brief Replace the contents of this BST with a height-balanced tree of sorted elements.
+     * Takes O(n) time with no rotations: every node is created once, in place,
+     * and its AVL height is set from its children on the way back up.
+     * @param sorted elements in ascending order. Repeated elements are only stored once.
+     * @param n number of elements
+     */
+    void buildFromSorted(const T* sorted, size_t n);
+
+    /**
+     * @brief Replace the contents of this BST with a height-balanced tree of the elements.
+     * Sorts a copy of the elements, then calls buildFromSorted, so it takes O(n log n) time.
+     * @param elements elements in any order. Repeated elements are only stored once.
+     * @param n number of elements
+     */
+    void buildFromUnsorted(const T* elements, size_t n);
+
     /**
      * Find a query element in this BST
      *
@@ -80,6 +161,71 @@ public:
      */
     bool find(const T &query) const;
 
+    /**
+     * @brief Return an iterator to the smallest element
+     * @return the first iterator, equal to end() if the BST is empty
+     */
+    Iterator begin() const;
+
+    /**
+     * @brief Return the iterator past the largest element
+     * @return the end iterator
+     */
+    Iterator end() const;
+
+    /**
+     * @brief Find the first element that is not less than key
+     * @param key the key to search for
+     * @return iterator to the element, end() if every element is less than key
+     */
+    Iterator lower_bound(const T &key) const;
+
+    /**
+     * @brief Call callback on every element e with lo <= e <= hi, in ascending order.
+     * Costs O(log n + k) for k elements in the range, without recursion or allocation.
+     * @param lo lower bound of the range
+     * @param hi upper bound of the range
+     * @param callback function taking a const T&
+     * @return the number of elements passed to callback
+     */
+    template <typename Callback>
+    unsigned int rangeScan(const T &lo, const T &hi, Callback callback) const;
+
+    /**
+     * @brief Export the elements into a read-only array in Eytzinger (breadth-first) order,
+     * searched without pointers, branches or cache misses on the top levels. See frozen_bst.h.
+     * @return the frozen copy. This BST is unchanged.
+     */
+    FrozenBST freeze() const;
+
+    /**
+     * @brief Export the elements into a read-only array in van Emde Boas order
+     * @return the frozen copy. This BST is unchanged.
+     */
+    FrozenBST freezeVanEmdeBoas() const;
+
+    /**
+     * @brief Count the elements smaller than key in O(log n) using subtree sizes
+     * @param key the key to rank, which does not have to be in the BST
+     * @return the number of elements less than key, which is key's 0-based position if it is in the BST
+     */
+    unsigned int rank(const T &key) const;
+
+    /**
+     * @brief Find the k-th smallest element in O(log n) using subtree sizes
+     * @param k 0-based position in sorted order
+     * @return the node holding the k-th smallest element, nullptr if k >= size()
+     */
+    Node *select(unsigned int k) const;
+
+    /**
+     * @brief Count the elements in the closed range [lo, hi] in O(log n)
+     * @param lo lower bound of the range
+     * @param hi upper bound of the range
+     * @return the number of elements e with lo <= e <= hi, 0 if hi < lo
+     */
+    unsigned int countRange(const T &lo, const T &hi) const;
+
     /**
      * Return pointer to the left-most node in this BST
      *
@@ -99,7 +245,7 @@ public:
     unsigned int size() const;
 
     /**
-     * @brief Return the maximum height of the BST. Root is at height 0
+     * @brief Return the maximum height of the BST, read from the root's stored height. Root is at height 0
      * @return The height of the BST
      */
     int height() const;
@@ -142,6 +288,37 @@ public:
      */
     bool insert(T element);
 
+    // Finger operations. A finger is a node of this BST, usually the last one touched,
+    // where a search starts instead of at the root. The search climbs parent pointers
+    // from the finger only until it reaches a subtree whose key range holds the target,
+    // then goes down, so on a stream of nearby keys each search compares O(log d) keys
+    // for a distance d in sorted order, instead of O(log n). The climb itself follows
+    // parent pointers without comparing up to the lowest common ancestor of the finger
+    // and the target. A finger is invalidated only when its own element is removed:
+    // removing a node with two children moves its successor node into its place,
+    // so the node of every other element stays where fingers point at it.
+    // Each search starts where the last one ended, so a stream of searches runs one at a
+    // time instead of overlapping; on keys without locality, find(query) is faster.
+
+    /**
+     * @brief Find a query element, starting from a finger
+     * @param query The query element to find
+     * @param finger a node of this BST or nullptr to start at the root. Set to the node holding
+     * query, or to the last node visited if query is not in the BST.
+     * @return true if query exists in this BST, otherwise false
+     */
+    bool find(const T &query, Node *&finger) const;
+
+    /**
+     * @brief Insert a new element, starting the search for its place from a finger.
+     * Repeated elements are stored like insert does. Subtree sizes are updated all the way
+     * to the root, which costs a climb of the parent pointers but no comparisons.
+     * @param element The new element to insert
+     * @param finger a node of this BST or nullptr to start at the root. Set to the new node.
+     * @return true
+     */
+    bool insert(T element, Node *&finger);
+
     /**
      * Remove an element from this BST. It should maintain the AVL property.
      * @param element The element to remove
@@ -160,6 +337,91 @@ public:
      * @return the balance factor for the input node
     */
     int balanceFactor(Node *node);
+
+    /**
+     * Counters of the work done keeping the tree balanced
+     */
+    struct Stats
+    {
+        unsigned long rotations = 0;    // single rotations; a double rotation counts as two
+        unsigned long visits = 0;       // nodes rebalanced on the way up from a change
+    };
+
+    /**
+     * @brief Return the rebalancing counters since construction or the last resetStats()
+     * @return the counters
+     */
+    const Stats &stats() const;
+
+    /**
+     * @brief Set the rebalancing counters back to zero
+     */
+    void resetStats();
+
+    // Set operations. They treat the trees as sets (no repeated elements) and move
+    // nodes between trees instead of copying them. Each one takes O(log n) time for
+    // split and join, and O(m log(n/m + 1)) work for the set operations, where m is
+    // the size of the smaller tree. The set operations recurse on the two halves of
+    // a split in parallel until threads tasks are running; threads = 0 means one task
+    // per hardware thread.
+
+    /**
+     * @brief Move the elements of this BST into two BSTs around key. This BST is left empty.
+     * @param key the key to split at
+     * @param less gets the elements smaller than key. Its old contents are cleared.
+     * @param greater gets the elements greater than key. Its old contents are cleared.
+     * @return true if key was in this BST. It goes into neither half.
+     */
+    bool split(const T &key, BST &less, BST &greater);
+
+    /**
+     * @brief Append the elements of greater, which must all be larger than the elements of this BST.
+     * greater is left empty.
+     * @param greater the BST to append
+     */
+    void join(BST &greater);
+
+    /**
+     * @brief Add every element of other to this BST. other is left empty.
+     * @param other the other set
+     * @param threads maximum number of parallel tasks, 0 for the number of hardware threads
+     */
+    void unionWith(BST &other, unsigned int threads = 0);
+
+    /**
+     * @brief Keep only the elements that are also in other. other is left empty.
+     * @param other the other set
+     * @param threads maximum number of parallel tasks, 0 for the number of hardware threads
+     */
+    void intersectWith(BST &other, unsigned int threads = 0);
+
+    /**
+     * @brief Remove every element that is in other. other is left empty.
+     * @param other the other set
+     * @param threads maximum number of parallel tasks, 0 for the number of hardware threads
+     */
+    void differenceWith(BST &other, unsigned int threads = 0);
+
+    /**
+     * @brief Insert a batch of elements in one pass. The batch is sorted and merged in with
+     * a union, or, when it is at least an eighth of the tree, by relinking the merged
+     * in-order list of nodes. Either way it avoids m root-to-leaf inserts and retraces.
+     * Unlike insert, elements already in the tree and repeats within the batch are stored once.
+     * @param elements the elements to insert, in any order
+     * @param n number of elements
+     * @return the number of elements added to the tree
+     */
+    size_t insertBatch(const T *elements, size_t n);
+
+    /**
+     * @brief Remove a batch of elements in one pass, merged out with a difference or by
+     * relinking the remaining nodes. Like remove, each distinct element of the batch removes
+     * one copy from the tree; repeats within the batch count once.
+     * @param elements the elements to remove, in any order
+     * @param n number of elements
+     * @return the number of elements removed from the tree
+     */
+    size_t removeBatch(const T *elements, size_t n);
 private:
     /**
      * Pointer to the root node of this BST
@@ -171,6 +433,36 @@ private:
      */
     unsigned int numElements;
 
+    /**
+     * Rebalancing counters
+     */
+    Stats counters;
+
+    /**
+     * @brief Climb from a finger to the lowest node visited whose subtree holds the place of key
+     * @param finger a node of this BST, or nullptr
+     * @param key the key to search for
+     * @return the node to start going down from, root if finger is nullptr
+     */
+    Node *fingerStart(Node *finger, const T &key) const;
+
+    /**
+     * @brief Build a balanced subtree from sorted[lo, hi), taking the middle element as its root
+     * @param sorted elements in strictly ascending order
+     * @param lo index of the first element of the subtree
+     * @param hi index past the last element of the subtree
+     * @param parent the parent of the subtree root
+     * @return the root of the subtree, nullptr if lo == hi
+     */
+    Node *buildSubtree(const T *sorted, size_t lo, size_t hi, Node *parent);
+
+    /**
+     * @brief Return the node after node in ascending order, or nullptr if node holds the largest element
+     * @param node a node in the BST
+     * @return the next node
+     */
+    static Node *nextInorder(Node *node);
+
     /**
      * @brief Rotate the subtree rooted at node to the left
      * @param node The root of the subtree to rotate
@@ -186,8 +478,107 @@ private:
     /**
      * @brief Rebalance the subtree rooted at node
      * @param node The root of the subtree to rebalance
+     * @return the root of the subtree after rebalancing
+     */
+    Node *rebalance(Node *node);
+
+    /**
+     * @brief Rebalance the ancestors of a changed subtree, from the bottom up.
+     * Stops at the first subtree whose height comes out unchanged, since nothing above it can change either.
+     * @param node the lowest node whose subtree changed
+     * @param oldHeight the height stored in node before the change
+     */
+    void retrace(Node *node, int oldHeight);
+
+    // Helpers for split, join and the set operations. They work on detached subtrees:
+    // they never read parent pointers or touch root, so tasks on disjoint subtrees can
+    // run them at the same time. Parent pointers are set as children are linked, and the
+    // caller clears the parent of the final root.
+
+    /**
+     * @brief Make left and right the children of node and update node's height and size
+     * @return node
      */
-    void rebalance(Node *node);
+    Node *link(Node *node, Node *left, Node *right);
+
+    /**
+     * @brief Rotate a detached subtree to the left or right
+     * @param node the subtree root
+     * @return the new subtree root
+     */
+    Node *rotateSubtreeLeft(Node *node);
+    Node *rotateSubtreeRight(Node *node);
+
+    /**
+     * @brief Restore the AVL property at the root of a detached subtree whose children differ in height by at most 2
+     * @param node the subtree root
+     * @return the new subtree root
+     */
+    Node *balanceSubtree(Node *node);
+
+    /**
+     * @brief Join two AVL subtrees and a middle node, all keys of left < middle < all keys of right
+     * @return the root of the joined subtree
+     */
+    Node *joinSubtrees(Node *left, Node *middle, Node *right);
+
+    /**
+     * @brief Join two AVL subtrees, all keys of left < all keys of right
+     * @return the root of the joined subtree
+     */
+    Node *joinSubtrees(Node *left, Node *right);
+
+    /**
+     * @brief Split a subtree around key
+     * @param node the subtree root
+     * @param key the key to split at
+     * @param less gets the subtree of keys smaller than key
+     * @param greater gets the subtree of keys greater than key
+     * @return the node holding key, detached, or nullptr if key is not in the subtree
+     */
+    Node *splitSubtree(Node *node, const T &key, Node *&less, Node *&greater);
+
+    /**
+     * @brief Unlink the smallest node of a subtree
+     * @param node the subtree root
+     * @param smallest gets the smallest node, detached
+     * @return the root of the remaining subtree
+     */
+    Node *removeSmallest(Node *node, Node *&smallest);
+
+    /**
+     * @brief Union, intersection or difference of two subtrees. Every node of both ends up
+     * in the result or is deleted.
+     * @param a the first subtree
+     * @param b the second subtree
+     * @param tasks number of parallel tasks this call may use
+     * @return the root of the result
+     */
+    Node *unionSubtrees(Node *a, Node *b, unsigned int tasks);
+    Node *intersectSubtrees(Node *a, Node *b, unsigned int tasks);
+    Node *differenceSubtrees(Node *a, Node *b, unsigned int tasks);
+
+    /**
+     * @brief Append the nodes of a subtree to a vector in order
+     * @param node the subtree root
+     * @param out gets the nodes
+     */
+    void collectNodes(Node *node, std::vector<Node*> &out);
+
+    /**
+     * @brief Link nodes[lo, hi) into a balanced subtree, taking the middle node as its root
+     * @param nodes nodes in ascending order of their data
+     * @param lo index of the first node of the subtree
+     * @param hi index past the last node of the subtree
+     * @return the root of the subtree, nullptr if lo == hi
+     */
+    Node *linkBalanced(Node **nodes, size_t lo, size_t hi);
+
+    /**
+     * @brief Make node the root of this BST, after a set operation
+     * @param node the new root
+     */
+    void setRoot(Node *node);
 
     /**
      * @brief Delete all nodes starting at the node called in the argument
@@ -196,9 +587,9 @@ private:
     void clear(Node* node);
 
     /**
-     * @brief recursive helper function to get height of the BST
-     * @param node the node to start recursive function
-     * @return height of subtree starting at node
+     * @brief helper function to get the height of a subtree
+     * @param node the root of the subtree, may be nullptr
+     * @return the stored height of node, -1 for nullptr
      */
     int height(Node *node) const;
 
@@ -217,7 +608,21 @@ private:
     bool removeNode(Node *node);
 
     /**
-     * @brief update the height of the input node
+     * @brief Take a node with at most one child out of the tree without deleting it,
+     * and rebalance its ancestors
+     * @param node the node to unlink
+     */
+    void unlinkNode(Node *node);
+
+    /**
+     * @brief Count the elements not greater than key
+     * @param key the key to rank
+     * @return the number of elements less than or equal to key
+     */
+    unsigned int rankUpper(const T &key) const;
+
+    /**
+     * @brief update the height and subtree size of the input node from its children
      * @param node the node of which height is updated
     */
     void updateHeight(Node* node);
@@ -241,4 +646,59 @@ private:
     bool replaceChild(Node *currentChild, Node *newChild, Node *node);
 };
 
+// Stepping an iterator is inlined into loops over the BST, so nextInorder and end are defined here.
+
+/**
+ * @brief Return the node after node in ascending order, or nullptr if node holds the largest element
+ * @param node a node in the BST
+ * @return the next node
+ */
+inline BST::Node *BST::nextInorder(Node *node)
+{
+    // the next node is the leftmost node of the right subtree if there is one
+    if (node->rightChild != nullptr)
+    {
+        node = node->rightChild;
+        while (node->leftChild != nullptr)
+        {
+            node = node->leftChild;
+        }
+        return node;
+    }
+    // otherwise it is the first ancestor that has node in its left subtree
+    while (node->parent != nullptr && node->parent->rightChild == node)
+    {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+/**
+ * @brief Return the iterator past the largest element
+ * @return the end iterator
+ */
+inline BST::Iterator BST::end() const
+{
+    return Iterator(nullptr);
+}
+
+/**
+ * @brief Call callback on every element e with lo <= e <= hi, in ascending order
+ * @param lo lower bound of the range
+ * @param hi upper bound of the range
+ * @param callback function taking a const T&
+ * @return the number of elements passed to callback
+ */
+template <typename Callback>
+unsigned int BST::rangeScan(const T &lo, const T &hi, Callback callback) const
+{
+    unsigned int count = 0;
+    for (Iterator it = lower_bound(lo); it != end() && !(hi < *it); ++it)
+    {
+        callback(*it);
+        count++;
+    }
+    return count;
+}
+
 #endif // ASSIGN_5_BST_H
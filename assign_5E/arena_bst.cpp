@@ -0,0 +1,374 @@
+/**
+ * Implementation of ArenaBST class.
+ */
+
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: cpp file arena_bst.cpp
+// @brief This class implements an AVL tree over arena-allocated nodes
+//=======================================================
+
+#include "arena_bst.h"
+#include <algorithm>
+#include <iostream>
+
+/**
+ * @brief ArenaBST default constructor. An empty tree with an empty arena.
+ */
+ArenaBST::ArenaBST() : freeList(NIL), root(NIL), numElements(0) {
+}
+
+/**
+ * @brief Return the number of elements in the tree
+ * @return The number of elements in the tree
+ */
+unsigned int ArenaBST::size() const {
+    return numElements;
+}
+
+/**
+ * @brief Return the height of the tree. Every node keeps its own height, so this is the root's.
+ * @return The height of the tree, -1 if it is empty
+ */
+int ArenaBST::height() const {
+    return height(root);
+}
+
+/**
+ * @brief Return the index of the root node
+ * @return The root index, NIL if the tree is empty
+ */
+ArenaBST::Index ArenaBST::getRoot() const {
+    return root;
+}
+
+/**
+ * @brief Return the node at an index
+ * @param i index of a node in the tree
+ * @return the node
+ */
+const ArenaBST::Node& ArenaBST::node(Index i) const {
+    return at(i);
+}
+
+/**
+ * @brief Return the number of bytes held by the arena, including unused and freed slots
+ * @return the arena size in bytes
+ */
+size_t ArenaBST::memoryUsage() const {
+    return nodes.capacity() * sizeof(Node) + heights.capacity();
+}
+
+/**
+ * @brief Remove all elements and give the arena back to the system.
+ * Nodes hold plain data, so this is a single deallocation whatever the size.
+ */
+void ArenaBST::clear() {
+    std::vector<Node>().swap(nodes);
+    std::vector<signed char>().swap(heights);
+    freeList = NIL;
+    root = NIL;
+    numElements = 0;
+}
+
+/**
+ * @brief Take a node from the free list or the arena and store element in it
+ * @param element the data of the new node
+ * @return the index of the new node
+ */
+ArenaBST::Index ArenaBST::allocate(T element) {
+    Index i = freeList;
+    if(i != NIL){
+        freeList = at(i).leftChild;
+    }
+    else{
+        i = nodes.size();
+        nodes.emplace_back();
+        heights.emplace_back();
+    }
+    Node& node = at(i);
+    node.data = element;
+    node.leftChild = node.rightChild = node.parent = NIL;
+    heights[i] = 0;
+    return i;
+}
+
+/**
+ * @brief Put a removed node on the free list
+ * @param i index of the node
+ */
+void ArenaBST::release(Index i) {
+    at(i).leftChild = freeList;
+    freeList = i;
+}
+
+/**
+ * @brief Find a query element in this tree
+ * @param query The query element to find
+ * @return true if query exists in this tree, otherwise false
+ */
+bool ArenaBST::find(const T &query) const {
+    Index cur = root;
+    while(cur != NIL){
+        const Node& node = at(cur);
+        if(node.data == query){
+            return true;
+        }
+        cur = (query < node.data) ? node.leftChild : node.rightChild;
+    }
+    return false;
+}
+
+/**
+ * @brief Insert a new element, then rebalance upward from the new node's parent
+ * @param element The new element to insert
+ * @return true if the insertion was successful, false if element is already in the tree
+ */
+bool ArenaBST::insert(T element) {
+    if(root == NIL){
+        root = allocate(element);
+        numElements++;
+        return true;
+    }
+    //find the leaf position of the new element
+    Index parent = root;
+    bool left = false;
+    while(true){
+        const Node& node = at(parent);
+        if(element == node.data){
+            return false;
+        }
+        left = element < node.data;
+        Index next = left ? node.leftChild : node.rightChild;
+        if(next == NIL){
+            break;
+        }
+        parent = next;
+    }
+    //allocate may move the arena, so no Node& is held across it
+    Index i = allocate(element);
+    int parentHeight = height(parent);
+    setChild(left, i, parent);
+    retrace(parent, parentHeight);
+    numElements++;
+    return true;
+}
+
+/**
+ * @brief Remove an element from this tree, maintaining the AVL property.
+ * @param element The element to remove
+ * @return true if the removal was successful, false if element was not found
+ */
+bool ArenaBST::remove(T element) {
+    Index cur = root;
+    while(cur != NIL && at(cur).data != element){
+        cur = (element < at(cur).data) ? at(cur).leftChild : at(cur).rightChild;
+    }
+    if(cur == NIL){
+        return false;
+    }
+    numElements--;
+    removeNode(cur);
+    return true;
+}
+
+/**
+ * @brief helper function for removing a node. Same cases as BST::removeNode.
+ * @param i the node to be removed, obtained from remove()
+ */
+void ArenaBST::removeNode(Index i) {
+    Node& node = at(i);
+    Index parent = node.parent;
+
+    //internal node with 2 children: take the successor's data and remove the successor instead
+    if(node.leftChild != NIL && node.rightChild != NIL){
+        Index successor = node.rightChild;
+        while(at(successor).leftChild != NIL){
+            successor = at(successor).leftChild;
+        }
+        node.data = at(successor).data;
+        removeNode(successor);
+        return;
+    }
+
+    Index child = (node.leftChild != NIL) ? node.leftChild : node.rightChild;
+    if(i == root){
+        root = child;
+        if(root != NIL){
+            at(root).parent = NIL;
+        }
+        release(i);
+        return;
+    }
+    int parentHeight = height(parent);
+    replaceChild(i, child, parent);
+    release(i);
+
+    //ancestors of the removed node may need rebalancing
+    retrace(parent, parentHeight);
+}
+
+/**
+ * @brief Rebalance the subtree rooted at node
+ * @param i The root of the subtree to rebalance
+ * @return the root of the subtree after rebalancing
+ */
+ArenaBST::Index ArenaBST::rebalance(Index i) {
+    updateHeight(i);
+    int balance = balanceFactor(i);
+    if(balance == -2){
+        if(balanceFactor(at(i).rightChild) == 1){
+            rotateRight(at(i).rightChild);
+        }
+        rotateLeft(i);
+        return at(i).parent;
+    }
+    else if(balance == 2){
+        if(balanceFactor(at(i).leftChild) == -1){
+            rotateLeft(at(i).leftChild);
+        }
+        rotateRight(i);
+        return at(i).parent;
+    }
+    return i;
+}
+
+/**
+ * @brief Rebalance the ancestors of a changed subtree, stopping at the first unchanged height.
+ * Same as BST::retrace.
+ * @param i the lowest node whose subtree changed
+ * @param oldHeight the height stored for i before the change
+ */
+void ArenaBST::retrace(Index i, int oldHeight) {
+    while(i != NIL){
+        Index parent = at(i).parent;
+        int parentHeight = height(parent);
+        i = rebalance(i);
+        if(height(i) == oldHeight){
+            if(parent != NIL){
+                updateHeight(parent);
+            }
+            return;
+        }
+        i = parent;
+        oldHeight = parentHeight;
+    }
+}
+
+/**
+ * @brief Rotate the subtree rooted at node to the left
+ * @param i The root of the subtree to rotate
+ */
+void ArenaBST::rotateLeft(Index i) {
+    Index rightChild = at(i).rightChild;
+    Index rightLeftChild = at(rightChild).leftChild;
+    //the right child moves up to the node's position
+    if(at(i).parent != NIL){
+        replaceChild(i, rightChild, at(i).parent);
+    }
+    else{
+        root = rightChild;
+        at(root).parent = NIL;
+    }
+    //the node becomes the left child of its old right child, then takes rightLeftChild as its right child
+    setChild(true, i, rightChild);
+    setChild(false, rightLeftChild, i);
+    updateHeight(rightChild);
+}
+
+/**
+ * @brief Rotate the subtree rooted at node to the right
+ * @param i The root of the subtree to rotate
+ */
+void ArenaBST::rotateRight(Index i) {
+    Index leftChild = at(i).leftChild;
+    Index leftRightChild = at(leftChild).rightChild;
+    //the left child moves up to the node's position
+    if(at(i).parent != NIL){
+        replaceChild(i, leftChild, at(i).parent);
+    }
+    else{
+        root = leftChild;
+        at(root).parent = NIL;
+    }
+    //the node becomes the right child of its old left child, then takes leftRightChild as its left child
+    setChild(false, i, leftChild);
+    setChild(true, leftRightChild, i);
+    updateHeight(leftChild);
+}
+
+/**
+ * @brief compute the balance factor of a node
+ * @param i index of a node in the tree
+ * @return the balance factor of the node
+ */
+int ArenaBST::balanceFactor(Index i) const {
+    return height(at(i).leftChild) - height(at(i).rightChild);
+}
+
+/**
+ * @brief update the height of the input node from the heights of its children
+ * @param i the node of which height is updated
+ */
+void ArenaBST::updateHeight(Index i) {
+    heights[i] = 1 + std::max(height(at(i).leftChild), height(at(i).rightChild));
+}
+
+/**
+ * @brief set left or right child of a node and update the node's height
+ * @param left true if assigning leftChild, false if assigning rightChild
+ * @param child the child to be assigned to node
+ * @param i the node of which child needs reassigning
+ */
+void ArenaBST::setChild(bool left, Index child, Index i) {
+    if(left){
+        at(i).leftChild = child;
+    }
+    else{
+        at(i).rightChild = child;
+    }
+    if(child != NIL){
+        at(child).parent = i;
+    }
+    updateHeight(i);
+}
+
+/**
+ * @brief replaces currentChild with newChild for node
+ * @param currentChild the currentChild which needs replacement
+ * @param newChild newChild to replace it
+ * @param i node that needs child replaced
+ */
+void ArenaBST::replaceChild(Index currentChild, Index newChild, Index i) {
+    if(at(i).leftChild == currentChild){
+        setChild(true, newChild, i);
+    }
+    else if(at(i).rightChild == currentChild){
+        setChild(false, newChild, i);
+    }
+}
+
+/**
+ * @brief Print the subtree at the given node using inorder traversal
+ * @param i index of a node in the tree
+ */
+void ArenaBST::printInorder(Index i) const {
+    if(i != NIL){
+        printInorder(at(i).leftChild);
+        std::cout << at(i).data << " ";
+        printInorder(at(i).rightChild);
+    }
+}
+
+/**
+ * @brief Print the balance factor of each node in the subtree in-order
+ * @param i index of the node at the root of the subtree
+ */
+void ArenaBST::printBalanceFactors(Index i) const {
+    if(i != NIL){
+        printBalanceFactors(at(i).leftChild);
+        std::cout << balanceFactor(i) << " ";
+        printBalanceFactors(at(i).rightChild);
+    }
+}
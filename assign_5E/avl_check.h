@@ -0,0 +1,128 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file avl_check.h
+// @brief This file defines the AVL invariant check shared by the tests
+//=======================================================
+//
+// BST, ArenaBST, PersistentBST and Map are all AVL trees, but their nodes are
+// laid out differently: Map names its key "key", PersistentBST has no parent
+// links because versions share nodes, only BST and PersistentBST keep subtree
+// sizes, and ArenaBST links nodes by index. checkAVLSubtree is written once
+// against a view, and each view below says how to read one layout. A view has
+//
+//  - Ref, the type that names a node, and isNil, left, right, key and height
+//  - parentIs and sizeIs, which are true when the tree keeps no such field
+//
+// The whole check is in this header and is only included by the tests.
+
+#ifndef ASSIGN_5E_AVL_CHECK_H
+#define ASSIGN_5E_AVL_CHECK_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "assert.h"
+
+/**
+ * @brief Check the links, stored heights, balance, subtree sizes and key order of a subtree,
+ * and collect its keys in order. Equal keys may sit next to each other.
+ * @param view reads the nodes of the tree
+ * @param node the root of the subtree
+ * @param parent the expected parent of node
+ * @param out gets the keys of the subtree
+ * @return the height of the subtree
+ */
+template <typename View, typename Key>
+int checkAVLSubtree(const View &view, typename View::Ref node, typename View::Ref parent, std::vector<Key> &out)
+{
+    if (view.isNil(node))
+    {
+        return -1;
+    }
+    assert(view.parentIs(node, parent));
+    size_t first = out.size();
+    int left = checkAVLSubtree(view, view.left(node), node, out);
+    size_t mid = out.size();
+    out.push_back(view.key(node));
+    int right = checkAVLSubtree(view, view.right(node), node, out);
+    //the in-order neighbours are the largest key on the left and the smallest on the right
+    assert(mid == first || !(out[mid] < out[mid - 1]));
+    assert(mid + 1 == out.size() || !(out[mid + 1] < out[mid]));
+    assert(left - right >= -1 && left - right <= 1);
+    assert(view.height(node) == 1 + std::max(left, right));
+    assert(view.sizeIs(node, out.size() - first));
+    return view.height(node);
+}
+
+/**
+ * @brief View of nodes with data, parent links and subtree sizes, like BST::Node
+ */
+template <typename Node>
+struct LinkedView
+{
+    typedef const Node *Ref;
+
+    bool isNil(Ref node) const { return node == nullptr; }
+    Ref left(Ref node) const { return node->leftChild; }
+    Ref right(Ref node) const { return node->rightChild; }
+    auto key(Ref node) const -> decltype((node->data)) { return node->data; }
+    int height(Ref node) const { return node->height; }
+    bool parentIs(Ref node, Ref parent) const { return node->parent == parent; }
+    bool sizeIs(Ref node, size_t size) const { return node->size == size; }
+};
+
+/**
+ * @brief View of nodes with data and subtree sizes but no parent links, like PersistentBST::Node
+ */
+template <typename Node>
+struct SharedView
+{
+    typedef const Node *Ref;
+
+    bool isNil(Ref node) const { return node == nullptr; }
+    Ref left(Ref node) const { return node->leftChild; }
+    Ref right(Ref node) const { return node->rightChild; }
+    auto key(Ref node) const -> decltype((node->data)) { return node->data; }
+    int height(Ref node) const { return node->height; }
+    bool parentIs(Ref, Ref) const { return true; }
+    bool sizeIs(Ref node, size_t size) const { return node->size == size; }
+};
+
+/**
+ * @brief View of map nodes with a key and parent links but no sizes, like Map::Node
+ */
+template <typename Node>
+struct MapView
+{
+    typedef const Node *Ref;
+
+    bool isNil(Ref node) const { return node == nullptr; }
+    Ref left(Ref node) const { return node->leftChild; }
+    Ref right(Ref node) const { return node->rightChild; }
+    auto key(Ref node) const -> decltype((node->key)) { return node->key; }
+    int height(Ref node) const { return node->height; }
+    bool parentIs(Ref node, Ref parent) const { return node->parent == parent; }
+    bool sizeIs(Ref, size_t) const { return true; }
+};
+
+/**
+ * @brief View of the nodes of an index-linked tree with heights kept apart, like ArenaBST
+ */
+template <typename Tree>
+struct ArenaView
+{
+    typedef typename Tree::Index Ref;
+
+    const Tree &tree;
+
+    bool isNil(Ref i) const { return i == Tree::NIL; }
+    Ref left(Ref i) const { return tree.node(i).leftChild; }
+    Ref right(Ref i) const { return tree.node(i).rightChild; }
+    auto key(Ref i) const -> decltype((tree.node(i).data)) { return tree.node(i).data; }
+    int height(Ref i) const { return tree.height(i); }
+    bool parentIs(Ref i, Ref parent) const { return tree.node(i).parent == parent; }
+    bool sizeIs(Ref, size_t) const { return true; }
+};
+
+#endif // ASSIGN_5E_AVL_CHECK_H
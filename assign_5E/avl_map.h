@@ -0,0 +1,648 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file avl_map.h
+// @brief This class defines an AVL tree map from keys to values
+//=======================================================
+//
+// BST stores int elements only, so using it as an index from a key to a
+// payload needs a second structure and a second lookup. Map is the same AVL
+// tree as a template on the key, the value and the comparison:
+//
+//  - A node holds its key and value inline, not through pointers, so a lookup
+//    reads the key it compares and the value it returns from the node it already
+//    loaded. The key comes first and the value last, so the key and the child
+//    links share the node's first cache line even when the value is large.
+//  - find returns a pointer to the value, nullptr if the key is missing, so
+//    looking up and reading or updating a value is one search.
+//  - If Compare defines is_transparent, find, lower_bound and remove also take
+//    any type Compare can compare with a Key, so a Map<std::string, V, C> can be
+//    searched with a const char* without building a std::string.
+//  - Nodes are never copied or moved once inserted: removing a node with two
+//    children relinks its successor in its place instead of copying the
+//    successor's key and value into it. A pointer returned by find stays valid
+//    until that key is removed.
+//
+// The whole class is in this header.
+
+#ifndef ASSIGN_5E_AVL_MAP_H
+#define ASSIGN_5E_AVL_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+/**
+ * Ordered map from Key to Value kept balanced with the AVL property
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key> >
+class Map
+{
+public:
+    /**
+     * A node of the tree. key never changes while the node is in the map.
+     */
+    struct Node
+    {
+        const Key key;
+        Node *leftChild;
+        Node *rightChild;
+        Node *parent;
+
+        /**
+         * The height of the node, 0 for a leaf
+         */
+        int height;
+        Value value;
+
+        Node(Key k, Value v) : key(std::move(k)), leftChild(nullptr), rightChild(nullptr), parent(nullptr),
+                               height(0), value(std::move(v)) {}
+    };
+
+    /**
+     * Iterator over the nodes in ascending key order. Values can be changed through it, keys cannot.
+     */
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Node value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Node *pointer;
+        typedef Node &reference;
+
+        /**
+         * @brief Iterator constructor
+         * @param node the node to start at, nullptr for the end
+         */
+        Iterator(Node *node = nullptr) : node(node) {}
+
+        Node &operator*() const { return *node; }
+        Node *operator->() const { return node; }
+
+        /**
+         * @brief Move to the next key in ascending order
+         */
+        Iterator &operator++()
+        {
+            node = nextInorder(node);
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator old = *this;
+            node = nextInorder(node);
+            return old;
+        }
+
+        bool operator==(const Iterator &other) const { return node == other.node; }
+        bool operator!=(const Iterator &other) const { return node != other.node; }
+
+    private:
+        Node *node;
+    };
+
+    /**
+     * Map Constructor, which initializes an empty map
+     * @param compare the comparison to order keys with
+     */
+    explicit Map(const Compare &compare = Compare()) : root(nullptr), numElements(0), less(compare) {}
+
+    /**
+     * Map Destructor, which frees every node
+     */
+    ~Map() { clear(); }
+
+    /**
+     * @brief Insert key with value, or replace the value if key is already in the map
+     * @param key the key
+     * @param value the value to store
+     * @return true if key was inserted, false if its value was replaced
+     */
+    bool insert_or_assign(Key key, Value value);
+
+    /**
+     * @brief Insert key with value if key is not in the map yet
+     * @param key the key
+     * @param value the value to store
+     * @return true if key was inserted, false if key was already in the map, which is left unchanged
+     */
+    bool insert(Key key, Value value);
+
+    /**
+     * @brief Return the value of key, inserting key with a default-constructed value first if it is missing
+     * @param key the key
+     * @return reference to the value in the map
+     */
+    Value &operator[](const Key &key);
+
+    /**
+     * @brief Find the value of a key
+     * @param key the key to search for
+     * @return pointer to the value in the map, nullptr if key is not in the map
+     */
+    Value *find(const Key &key) { return valueOf(findNode(key)); }
+    const Value *find(const Key &key) const { return valueOf(findNode(key)); }
+
+    /**
+     * @brief Find the value of a key given as another type. Only exists if Compare is transparent.
+     * @param key anything Compare can compare with a Key
+     * @return pointer to the value in the map, nullptr if key is not in the map
+     */
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    Value *find(const K &key) { return valueOf(findNode(key)); }
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const Value *find(const K &key) const { return valueOf(findNode(key)); }
+
+    /**
+     * @brief Find the first key that is not less than key
+     * @param key the key to search for
+     * @return iterator to the node, end() if every key is less than key
+     */
+    Iterator lower_bound(const Key &key) const { return Iterator(lowerBoundNode(key)); }
+
+    /**
+     * @brief lower_bound for a key given as another type. Only exists if Compare is transparent.
+     */
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    Iterator lower_bound(const K &key) const { return Iterator(lowerBoundNode(key)); }
+
+    /**
+     * @brief Remove a key and its value
+     * @param key the key to remove
+     * @return true if the removal was successful, false if key was not found
+     */
+    bool remove(const Key &key) { return removeNode(findNode(key)); }
+
+    /**
+     * @brief remove for a key given as another type. Only exists if Compare is transparent.
+     */
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    bool remove(const K &key) { return removeNode(findNode(key)); }
+
+    /**
+     * @brief Remove all keys and free every node
+     */
+    void clear()
+    {
+        clear(root);
+        root = nullptr;
+        numElements = 0;
+    }
+
+    /**
+     * @brief Return the number of keys in the map
+     */
+    size_t size() const { return numElements; }
+
+    /**
+     * @brief Return the height of the tree, -1 if it is empty. Root is at height 0
+     */
+    int height() const { return height(root); }
+
+    /**
+     * @brief Return the root node, nullptr if the map is empty
+     */
+    const Node *getRoot() const { return root; }
+
+    /**
+     * @brief Return an iterator to the smallest key
+     */
+    Iterator begin() const;
+
+    /**
+     * @brief Return the iterator past the largest key
+     */
+    Iterator end() const { return Iterator(); }
+
+private:
+    Node *root;
+
+    size_t numElements;
+
+    Compare less;
+
+    Map(const Map &);
+    Map &operator=(const Map &);
+
+    static Value *valueOf(Node *node) { return node ? &node->value : nullptr; }
+
+    static int height(const Node *node) { return node ? node->height : -1; }
+
+    static Node *nextInorder(Node *node);
+
+    static void clear(Node *node);
+
+    template <typename K>
+    Node *findNode(const K &key) const;
+
+    template <typename K>
+    Node *lowerBoundNode(const K &key) const;
+
+    Node *&childLink(bool &found, const Key &key, Node *&parent);
+
+    void attach(Node *node, Node *parent, Node *&link);
+
+    bool removeNode(Node *node);
+
+    void replaceChild(Node *node, Node *child);
+
+    void updateHeight(Node *node);
+
+    Node *rotateLeft(Node *node);
+
+    Node *rotateRight(Node *node);
+
+    Node *rebalance(Node *node);
+
+    void retrace(Node *node);
+};
+
+/**
+ * @brief Return the node after node in ascending order, following child and parent pointers
+ * @param node the current node
+ * @return the next node, nullptr after the largest
+ */
+template <typename Key, typename Value, typename Compare>
+typename Map<Key, Value, Compare>::Node *Map<Key, Value, Compare>::nextInorder(Node *node)
+{
+    if (node->rightChild)
+    {
+        node = node->rightChild;
+        while (node->leftChild)
+        {
+            node = node->leftChild;
+        }
+        return node;
+    }
+    while (node->parent && node->parent->rightChild == node)
+    {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+/**
+ * @brief Delete all nodes of a subtree, recursing only into left children
+ * @param node the subtree root
+ */
+template <typename Key, typename Value, typename Compare>
+void Map<Key, Value, Compare>::clear(Node *node)
+{
+    while (node)
+    {
+        clear(node->leftChild);
+        Node *right = node->rightChild;
+        delete node;
+        node = right;
+    }
+}
+
+/**
+ * @brief Return an iterator to the smallest key
+ */
+template <typename Key, typename Value, typename Compare>
+typename Map<Key, Value, Compare>::Iterator Map<Key, Value, Compare>::begin() const
+{
+    Node *node = root;
+    while (node && node->leftChild)
+    {
+        node = node->leftChild;
+    }
+    return Iterator(node);
+}
+
+/**
+ * @brief Find the node holding a key
+ * @param key a Key, or anything a transparent Compare can compare with one
+ * @return the node, nullptr if key is not in the map
+ */
+template <typename Key, typename Value, typename Compare>
+template <typename K>
+typename Map<Key, Value, Compare>::Node *Map<Key, Value, Compare>::findNode(const K &key) const
+{
+    Node *node = root;
+    while (node)
+    {
+        if (less(key, node->key))
+        {
+            node = node->leftChild;
+        }
+        else if (less(node->key, key))
+        {
+            node = node->rightChild;
+        }
+        else
+        {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Find the node holding the first key that is not less than key
+ * @param key a Key, or anything a transparent Compare can compare with one
+ * @return the node, nullptr if every key is less than key
+ */
+template <typename Key, typename Value, typename Compare>
+template <typename K>
+typename Map<Key, Value, Compare>::Node *Map<Key, Value, Compare>::lowerBoundNode(const K &key) const
+{
+    Node *node = root;
+    Node *best = nullptr;
+    while (node)
+    {
+        if (less(node->key, key))
+        {
+            node = node->rightChild;
+        }
+        else
+        {
+            best = node;
+            node = node->leftChild;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Search for key and return the child link where it is or would be
+ * @param found set to whether the link holds key
+ * @param key the key to search for
+ * @param parent set to the node owning the link, nullptr for the root link
+ * @return the link
+ */
+template <typename Key, typename Value, typename Compare>
+typename Map<Key, Value, Compare>::Node *&Map<Key, Value, Compare>::childLink(bool &found, const Key &key, Node *&parent)
+{
+    Node **link = &root;
+    parent = nullptr;
+    while (*link)
+    {
+        if (less(key, (*link)->key))
+        {
+            parent = *link;
+            link = &parent->leftChild;
+        }
+        else if (less((*link)->key, key))
+        {
+            parent = *link;
+            link = &parent->rightChild;
+        }
+        else
+        {
+            found = true;
+            return *link;
+        }
+    }
+    found = false;
+    return *link;
+}
+
+/**
+ * @brief Link a new leaf at an empty child link and rebalance its ancestors
+ * @param node the new node
+ * @param parent the node owning link, nullptr for the root
+ * @param link the empty link returned by childLink
+ */
+template <typename Key, typename Value, typename Compare>
+void Map<Key, Value, Compare>::attach(Node *node, Node *parent, Node *&link)
+{
+    node->parent = parent;
+    link = node;
+    numElements++;
+    retrace(parent);
+}
+
+/**
+ * @brief Insert key with value, or replace the value if key is already in the map
+ */
+template <typename Key, typename Value, typename Compare>
+bool Map<Key, Value, Compare>::insert_or_assign(Key key, Value value)
+{
+    bool found;
+    Node *parent;
+    Node *&link = childLink(found, key, parent);
+    if (found)
+    {
+        link->value = std::move(value);
+        return false;
+    }
+    attach(new Node(std::move(key), std::move(value)), parent, link);
+    return true;
+}
+
+/**
+ * @brief Insert key with value if key is not in the map yet
+ */
+template <typename Key, typename Value, typename Compare>
+bool Map<Key, Value, Compare>::insert(Key key, Value value)
+{
+    bool found;
+    Node *parent;
+    Node *&link = childLink(found, key, parent);
+    if (found)
+    {
+        return false;
+    }
+    attach(new Node(std::move(key), std::move(value)), parent, link);
+    return true;
+}
+
+/**
+ * @brief Return the value of key, inserting key with a default-constructed value first if it is missing
+ */
+template <typename Key, typename Value, typename Compare>
+Value &Map<Key, Value, Compare>::operator[](const Key &key)
+{
+    bool found;
+    Node *parent;
+    Node *&link = childLink(found, key, parent);
+    if (found)
+    {
+        return link->value;
+    }
+    Node *node = new Node(key, Value());
+    attach(node, parent, link);
+    return node->value;
+}
+
+/**
+ * @brief Unlink a node and delete it. A node with two children is replaced by its successor
+ * node, which keeps its key and value, so no key or value is copied.
+ * @param node the node to remove, or nullptr
+ * @return true if a node was removed
+ */
+template <typename Key, typename Value, typename Compare>
+bool Map<Key, Value, Compare>::removeNode(Node *node)
+{
+    if (node == nullptr)
+    {
+        return false;
+    }
+    if (node->leftChild && node->rightChild)
+    {
+        Node *successor = node->rightChild;
+        while (successor->leftChild)
+        {
+            successor = successor->leftChild;
+        }
+        //the lowest node whose subtree lost a node
+        Node *changed = successor;
+        if (successor != node->rightChild)
+        {
+            changed = successor->parent;
+            changed->leftChild = successor->rightChild;
+            if (successor->rightChild)
+            {
+                successor->rightChild->parent = changed;
+            }
+            successor->rightChild = node->rightChild;
+            successor->rightChild->parent = successor;
+        }
+        successor->leftChild = node->leftChild;
+        successor->leftChild->parent = successor;
+        //the stored height of the old node, so retrace sees the heights from before the remove
+        successor->height = node->height;
+        replaceChild(node, successor);
+        retrace(changed);
+    }
+    else
+    {
+        Node *parent = node->parent;
+        replaceChild(node, node->leftChild ? node->leftChild : node->rightChild);
+        retrace(parent);
+    }
+    delete node;
+    numElements--;
+    return true;
+}
+
+/**
+ * @brief Put child where node is in its parent, or at the root
+ * @param node the node being replaced
+ * @param child the node taking its place, or nullptr
+ */
+template <typename Key, typename Value, typename Compare>
+void Map<Key, Value, Compare>::replaceChild(Node *node, Node *child)
+{
+    Node *parent = node->parent;
+    if (child)
+    {
+        child->parent = parent;
+    }
+    if (parent == nullptr)
+    {
+        root = child;
+    }
+    else if (parent->leftChild == node)
+    {
+        parent->leftChild = child;
+    }
+    else
+    {
+        parent->rightChild = child;
+    }
+}
+
+template <typename Key, typename Value, typename Compare>
+void Map<Key, Value, Compare>::updateHeight(Node *node)
+{
+    node->height = 1 + std::max(height(node->leftChild), height(node->rightChild));
+}
+
+/**
+ * @brief Rotate node's right child up into node's place
+ * @return the new subtree root
+ */
+template <typename Key, typename Value, typename Compare>
+typename Map<Key, Value, Compare>::Node *Map<Key, Value, Compare>::rotateLeft(Node *node)
+{
+    Node *right = node->rightChild;
+    node->rightChild = right->leftChild;
+    if (right->leftChild)
+    {
+        right->leftChild->parent = node;
+    }
+    replaceChild(node, right);
+    right->leftChild = node;
+    node->parent = right;
+    updateHeight(node);
+    updateHeight(right);
+    return right;
+}
+
+/**
+ * @brief Rotate node's left child up into node's place
+ * @return the new subtree root
+ */
+template <typename Key, typename Value, typename Compare>
+typename Map<Key, Value, Compare>::Node *Map<Key, Value, Compare>::rotateRight(Node *node)
+{
+    Node *left = node->leftChild;
+    node->leftChild = left->rightChild;
+    if (left->rightChild)
+    {
+        left->rightChild->parent = node;
+    }
+    replaceChild(node, left);
+    left->rightChild = node;
+    node->parent = left;
+    updateHeight(node);
+    updateHeight(left);
+    return left;
+}
+
+/**
+ * @brief Recompute node's height and rotate if its children's heights differ by 2
+ * @return the root of the subtree after rebalancing
+ */
+template <typename Key, typename Value, typename Compare>
+typename Map<Key, Value, Compare>::Node *Map<Key, Value, Compare>::rebalance(Node *node)
+{
+    updateHeight(node);
+    int balance = height(node->leftChild) - height(node->rightChild);
+    if (balance == 2)
+    {
+        if (height(node->leftChild->leftChild) < height(node->leftChild->rightChild))
+        {
+            rotateLeft(node->leftChild);
+        }
+        return rotateRight(node);
+    }
+    if (balance == -2)
+    {
+        if (height(node->rightChild->rightChild) < height(node->rightChild->leftChild))
+        {
+            rotateRight(node->rightChild);
+        }
+        return rotateLeft(node);
+    }
+    return node;
+}
+
+/**
+ * @brief Rebalance from node up, stopping at the first subtree whose height did not change.
+ * The heights stored above node must still be the ones from before the change.
+ * @param node the lowest node whose subtree changed, or nullptr
+ */
+template <typename Key, typename Value, typename Compare>
+void Map<Key, Value, Compare>::retrace(Node *node)
+{
+    while (node)
+    {
+        int oldHeight = node->height;
+        node = rebalance(node);
+        if (node->height == oldHeight)
+        {
+            return;
+        }
+        node = node->parent;
+    }
+}
+
+#endif // ASSIGN_5E_AVL_MAP_H
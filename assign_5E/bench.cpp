@@ -0,0 +1,1040 @@
+/**
+ * Benchmarks for the AVL trees.
+ * Usage: ./bench <benchmark> [number of keys]
+ *
+ *   arena   ArenaBST against BST (default 10^7 keys). For each tree the keys are
+ *           inserted in random order, then every key is looked up in another random
+ *           order, followed by as many misses. Memory is the growth of the resident
+ *           set while the tree is built.
+ *   build   an insert loop against buildFromSorted and buildFromUnsorted (default 10^6 keys)
+ *   retrace nodes visited and rotations done by rebalancing on inserts and removes in random
+ *           order, against the ancestors a retrace all the way to the root would visit (default 10^6 keys).
+ *           Counting the ancestors walks the search path first, so the timed operations find it in cache.
+ *   order   rank, select and countRange against binary search on a sorted vector, and countRange
+ *           against walking the range with successor() (default 10^6 keys)
+ *   scan    full in-order scans with the iterator against a recursive traversal, rangeScan over
+ *           ranges of 1000 elements, and iterator scans of a bulk-loaded tree (default 10^6 keys)
+ *   setops  unionWith, intersectWith and differenceWith of two random sets of n keys with 1, 2, 4
+ *           and 8 tasks, against std::set_union and friends on sorted vectors, and a union of
+ *           n/1000 keys into n keys against inserting them one at a time (default 10^7 keys)
+ *   batch   insertBatch and removeBatch of n and n/100 random keys on a tree of n keys, against
+ *           insert and remove loops (default 10^6 keys)
+ *   snapshot lookups per second from 1, 2 and 4 reader threads on a tree of n keys, with and
+ *           without a writer thread inserting and removing keys, for PersistentBST snapshots
+ *           against a BST behind one mutex (default 10^6 keys)
+ *   frozen  nanoseconds per random lookup in the AVL tree against its frozen Eytzinger and van Emde
+ *           Boas arrays and std::lower_bound on a sorted vector, at 10^6 and 10^7 keys, or at
+ *           the given number of keys. The AVL tree is skipped above 3*10^7 keys (40 bytes a node).
+ *   btree   inserts in random order, random lookups and full scans of the AVL tree against
+ *           B+-trees with 1, 2 and 4 cache lines of keys per node (default 10^7 keys)
+ *   startup time until the first lookups are answered after a restart: reading a text dump of
+ *           n keys and inserting them, reading it and bulk loading, and mapping a file saved by
+ *           MappedBST, whose pages are dropped from the page cache first (default 10^7 keys)
+ *   map     Map<int, int> against std::map<int, int>: inserts in random order, random lookups of
+ *           the value half of them missing, full scans and removes in random order (default 10^6 keys)
+ *   finger  insert and find from the root against insert and find from a finger at the last node
+ *           touched, on a sorted stream, a nearly sorted one (each key moved up to 16 places, 1%
+ *           moved anywhere) and a random one (default 10^6 keys)
+ */
+#include "BST.h"
+#include "arena_bst.h"
+#include "avl_map.h"
+#include "bplus_tree.h"
+#include "frozen_bst.h"
+#include "mapped_bst.h"
+#include "persistent_bst.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <stdlib.h>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Return the resident set size of this process in bytes
+ */
+long residentBytes() {
+    long pages = 0, resident = 0;
+    ifstream statm("/proc/self/statm");
+    statm >> pages >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief Build a tree from keys, look every key and as many missing keys up, and report
+ * @param name name printed for the tree
+ * @param tree an empty tree
+ * @param keys distinct keys in insertion order
+ * @param queries the same keys in another order
+ */
+template <typename Tree>
+void runArena(const char* name, Tree& tree, const vector<T>& keys, const vector<T>& queries) {
+    long before = residentBytes();
+    auto start = chrono::steady_clock::now();
+    for (T key : keys) {
+        tree.insert(key);
+    }
+    chrono::duration<double> insertTime = chrono::steady_clock::now() - start;
+    long memory = residentBytes() - before;
+
+    start = chrono::steady_clock::now();
+    long found = 0;
+    for (T key : queries) {
+        found += tree.find(key);
+        found += tree.find(-key - 1);       // keys are non-negative, so this is a miss
+    }
+    chrono::duration<double> findTime = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    tree.clear();
+    chrono::duration<double> clearTime = chrono::steady_clock::now() - start;
+
+    double n = keys.size();
+    cout << name << ": insert " << n / insertTime.count() / 1e6 << " M/s, find "
+         << 2 * n / findTime.count() / 1e6 << " M/s (" << found << " found), clear "
+         << clearTime.count() * 1e3 << " ms, memory " << memory / 1e6 << " MB = "
+         << memory / n << " bytes/key" << endl;
+}
+
+/**
+ * @brief Return the keys 0 to n - 1 in random order
+ */
+vector<T> shuffledKeys(int n, mt19937& rng) {
+    vector<T> keys(n);
+    for (int i = 0; i < n; i++) {
+        keys[i] = i;
+    }
+    shuffle(keys.begin(), keys.end(), rng);
+    return keys;
+}
+
+/**
+ * @brief Compare ArenaBST with BST
+ */
+void benchArena(int n) {
+    mt19937 rng(1);
+    vector<T> keys = shuffledKeys(n, rng);
+    vector<T> queries = keys;
+    shuffle(queries.begin(), queries.end(), rng);
+
+    cout << n << " keys, node size: BST " << sizeof(BST::Node) << " bytes, ArenaBST "
+         << sizeof(ArenaBST::Node) << " + 1 bytes" << endl;
+    // the arena goes first: its memory is returned to the system by clear(),
+    // while freed BST nodes stay in the allocator and would hide the arena's growth
+    {
+        ArenaBST tree;
+        runArena("ArenaBST", tree, keys, queries);
+    }
+    {
+        BST tree;
+        runArena("BST     ", tree, keys, queries);
+    }
+}
+
+/**
+ * @brief Time one way of building a tree and print the rate and the resulting height
+ * @param name name of the build
+ * @param n number of keys
+ * @param build function that fills the tree
+ */
+template <typename Build>
+void runBuild(const char* name, int n, Build build) {
+    BST bst;
+    auto start = chrono::steady_clock::now();
+    build(bst);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << name << ": " << elapsed.count() * 1e3 << " ms, " << n / elapsed.count() / 1e6
+         << " M keys/s, height " << bst.height() << endl;
+}
+
+/**
+ * @brief Compare an insert loop with the bulk builds
+ */
+void benchBuild(int n) {
+    mt19937 rng(1);
+    vector<T> shuffled = shuffledKeys(n, rng);
+    vector<T> sorted = shuffled;
+    sort(sorted.begin(), sorted.end());
+
+    cout << n << " keys" << endl;
+    runBuild("insert loop, sorted order", n, [&](BST& bst) {
+        for (T key : sorted) {
+            bst.insert(key);
+        }
+    });
+    runBuild("insert loop, random order", n, [&](BST& bst) {
+        for (T key : shuffled) {
+            bst.insert(key);
+        }
+    });
+    runBuild("buildFromSorted          ", n, [&](BST& bst) { bst.buildFromSorted(sorted.data(), n); });
+    runBuild("buildFromUnsorted        ", n, [&](BST& bst) { bst.buildFromUnsorted(shuffled.data(), n); });
+}
+
+/**
+ * @brief Count the ancestors of the node that an insert or remove of key would physically add or unlink
+ * @param bst the tree
+ * @param key the key to insert or remove
+ * @return the number of nodes a retrace to the root would rebalance
+ */
+long ancestors(BST& bst, T key) {
+    long depth = 0;
+    BST::Node* node = bst.getRoot();
+    while (node != nullptr && node->data != key) {
+        node = key < node->data ? node->leftChild : node->rightChild;
+        depth++;
+    }
+    if (node == nullptr) {
+        return depth;                       // insert: every node on the search path
+    }
+    if (node->leftChild != nullptr && node->rightChild != nullptr) {
+        node = node->rightChild;            // remove of a node with two children unlinks its successor
+        depth++;
+        while (node->leftChild != nullptr) {
+            node = node->leftChild;
+            depth++;
+        }
+    }
+    return depth;
+}
+
+/**
+ * @brief Count rebalancing work per insert and per remove
+ */
+void benchRetrace(int n) {
+    mt19937 rng(1);
+    vector<T> keys = shuffledKeys(n, rng);
+    BST bst;
+    long fullRetrace = 0;
+    chrono::duration<double> elapsed(0);
+    for (T key : keys) {
+        fullRetrace += ancestors(bst, key);
+        auto start = chrono::steady_clock::now();
+        bst.insert(key);
+        elapsed += chrono::steady_clock::now() - start;
+    }
+    cout << n << " inserts: " << (double)bst.stats().visits / n << " visits and "
+         << (double)bst.stats().rotations / n << " rotations per insert, full retrace "
+         << (double)fullRetrace / n << " visits, " << n / elapsed.count() / 1e6 << " M/s" << endl;
+
+    shuffle(keys.begin(), keys.end(), rng);
+    bst.resetStats();
+    fullRetrace = 0;
+    elapsed = chrono::duration<double>(0);
+    for (T key : keys) {
+        fullRetrace += ancestors(bst, key);
+        auto start = chrono::steady_clock::now();
+        bst.remove(key);
+        elapsed += chrono::steady_clock::now() - start;
+    }
+    cout << n << " removes: " << (double)bst.stats().visits / n << " visits and "
+         << (double)bst.stats().rotations / n << " rotations per remove, full retrace "
+         << (double)fullRetrace / n << " visits, " << n / elapsed.count() / 1e6 << " M/s" << endl;
+}
+
+/**
+ * @brief Time a query loop and print its rate
+ * @param name name of the query
+ * @param queries number of queries the loop runs
+ * @param loop function running the queries and returning a checksum
+ */
+template <typename Loop>
+void runQueries(const char* name, int queries, Loop loop) {
+    auto start = chrono::steady_clock::now();
+    long checksum = loop();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << name << ": " << queries / elapsed.count() / 1e6 << " M/s (checksum " << checksum << ")" << endl;
+}
+
+/**
+ * @brief Compare the order-statistic queries with a sorted vector
+ */
+void benchOrder(int n) {
+    mt19937 rng(1);
+    vector<T> keys = shuffledKeys(n, rng);
+    BST bst;
+    for (T key : keys) {
+        bst.insert(2 * key);                // even keys, so half the probes miss
+    }
+    vector<T> sorted(n);
+    for (int i = 0; i < n; i++) {
+        sorted[i] = 2 * i;
+    }
+    int q = 1000000;
+    vector<T> probes(q);
+    uniform_int_distribution<T> any(0, 2 * n);
+    for (T& probe : probes) {
+        probe = any(rng);
+    }
+    const int width = 2000;                 // countRange spans about 1000 elements
+
+    cout << n << " keys, " << q << " queries" << endl;
+    runQueries("rank                  ", q, [&]() {
+        long sum = 0;
+        for (T probe : probes) {
+            sum += bst.rank(probe);
+        }
+        return sum;
+    });
+    runQueries("rank, sorted vector   ", q, [&]() {
+        long sum = 0;
+        for (T probe : probes) {
+            sum += lower_bound(sorted.begin(), sorted.end(), probe) - sorted.begin();
+        }
+        return sum;
+    });
+    runQueries("select                ", q, [&]() {
+        long sum = 0;
+        for (T probe : probes) {
+            sum += bst.select(probe / 2 % n)->data;
+        }
+        return sum;
+    });
+    runQueries("countRange            ", q, [&]() {
+        long sum = 0;
+        for (T probe : probes) {
+            sum += bst.countRange(probe, probe + width);
+        }
+        return sum;
+    });
+    runQueries("countRange, vector    ", q, [&]() {
+        long sum = 0;
+        for (T probe : probes) {
+            sum += upper_bound(sorted.begin(), sorted.end(), probe + width) - lower_bound(sorted.begin(), sorted.end(), probe);
+        }
+        return sum;
+    });
+    runQueries("countRange, successor ", q / 100, [&]() {
+        long sum = 0;
+        for (int i = 0; i < q / 100; i++) {
+            BST::Node* node = bst.select(bst.rank(probes[i]));
+            for (; node != nullptr && node->data <= probes[i] + width; node = bst.successor(node)) {
+                sum++;
+            }
+        }
+        return sum;
+    });
+}
+
+/**
+ * @brief Sum a subtree with a recursive in-order traversal
+ */
+long sumRecursive(BST::Node* node) {
+    if (node == nullptr) {
+        return 0;
+    }
+    return sumRecursive(node->leftChild) + node->data + sumRecursive(node->rightChild);
+}
+
+/**
+ * @brief Time full scans and range scans. Inserting in random order scatters consecutive
+ * keys over the heap, while a bulk-loaded tree allocates them in order.
+ */
+void benchScan(int n) {
+    mt19937 rng(1);
+    vector<T> keys = shuffledKeys(n, rng);
+    BST bst;
+    for (T key : keys) {
+        bst.insert(key);
+    }
+    sort(keys.begin(), keys.end());
+    BST bulk;
+    bulk.buildFromSorted(keys.data(), n);
+    const int scans = 20;
+    const int ranges = 10000;
+    uniform_int_distribution<T> any(0, n - 1000);
+
+    cout << n << " keys" << endl;
+    runQueries("iterator scan             ", scans * n, [&]() {
+        long sum = 0;
+        for (int i = 0; i < scans; i++) {
+            for (T element : bst) {
+                sum += element;
+            }
+        }
+        return sum;
+    });
+    runQueries("recursive scan            ", scans * n, [&]() {
+        long sum = 0;
+        for (int i = 0; i < scans; i++) {
+            sum += sumRecursive(bst.getRoot());
+        }
+        return sum;
+    });
+    runQueries("rangeScan of 1000         ", ranges * 1000, [&]() {
+        long sum = 0;
+        for (int i = 0; i < ranges; i++) {
+            T lo = any(rng);
+            bst.rangeScan(lo, lo + 999, [&sum](const T& element) { sum += element; });
+        }
+        return sum;
+    });
+    runQueries("iterator scan, bulk-loaded", scans * n, [&]() {
+        long sum = 0;
+        for (int i = 0; i < scans; i++) {
+            for (T element : bulk) {
+                sum += element;
+            }
+        }
+        return sum;
+    });
+}
+
+/**
+ * @brief Time one set operation on two trees built from sorted keys. Building is not timed.
+ * @param name name of the operation
+ * @param a the first set, sorted
+ * @param b the second set, sorted
+ * @param operation function combining the two trees
+ */
+template <typename Operation>
+void runSetOperation(const string& name, const vector<T>& a, const vector<T>& b, Operation operation) {
+    BST first, second;
+    first.buildFromSorted(a.data(), a.size());
+    second.buildFromSorted(b.data(), b.size());
+    auto start = chrono::steady_clock::now();
+    operation(first, second);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << name << ": " << elapsed.count() * 1e3 << " ms, " << first.size() << " elements" << endl;
+}
+
+/**
+ * @brief Time std::set_union and friends on sorted vectors
+ */
+template <typename Algorithm>
+void runVectorSetOperation(const string& name, const vector<T>& a, const vector<T>& b, Algorithm algorithm) {
+    vector<T> out;
+    out.reserve(a.size() + b.size());
+    auto start = chrono::steady_clock::now();
+    algorithm(a.begin(), a.end(), b.begin(), b.end(), back_inserter(out));
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << name << ": " << elapsed.count() * 1e3 << " ms, " << out.size() << " elements" << endl;
+}
+
+/**
+ * @brief Return count random keys below limit, sorted and without repeats
+ */
+vector<T> sortedRandomKeys(int count, T limit, mt19937& rng) {
+    uniform_int_distribution<T> any(0, limit - 1);
+    vector<T> keys(count);
+    for (T& key : keys) {
+        key = any(rng);
+    }
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+/**
+ * @brief Time the set operations with different numbers of tasks
+ */
+void benchSetOperations(int n) {
+    mt19937 rng(1);
+    vector<T> a = sortedRandomKeys(n, 2 * n, rng);
+    vector<T> b = sortedRandomKeys(n, 2 * n, rng);
+    cout << a.size() << " and " << b.size() << " keys, " << thread::hardware_concurrency()
+         << " hardware threads" << endl;
+    for (unsigned int threads : {1u, 2u, 4u, 8u}) {
+        string tasks = " " + to_string(threads) + " task" + (threads == 1 ? " " : "s");
+        runSetOperation("unionWith,     " + tasks, a, b, [threads](BST& first, BST& second) { first.unionWith(second, threads); });
+        runSetOperation("intersectWith, " + tasks, a, b, [threads](BST& first, BST& second) { first.intersectWith(second, threads); });
+        runSetOperation("differenceWith," + tasks, a, b, [threads](BST& first, BST& second) { first.differenceWith(second, threads); });
+    }
+    runVectorSetOperation("std::set_union         ", a, b, set_union<vector<T>::const_iterator, vector<T>::const_iterator, back_insert_iterator<vector<T> > >);
+    runVectorSetOperation("std::set_intersection  ", a, b, set_intersection<vector<T>::const_iterator, vector<T>::const_iterator, back_insert_iterator<vector<T> > >);
+    runVectorSetOperation("std::set_difference    ", a, b, set_difference<vector<T>::const_iterator, vector<T>::const_iterator, back_insert_iterator<vector<T> > >);
+
+    //a small set into a large one: the split/join union only touches O(m log(n/m)) nodes
+    vector<T> few = sortedRandomKeys(max(n / 1000, 1), 2 * n, rng);
+    cout << few.size() << " keys into " << a.size() << endl;
+    runSetOperation("unionWith, 1 task        ", a, few, [](BST& first, BST& second) { first.unionWith(second, 1); });
+    runSetOperation("find and insert loop     ", a, few, [&few](BST& first, BST&) {
+        //insert keeps repeated elements, so skip the keys that are already there
+        for (T key : few) {
+            if (!first.find(key)) {
+                first.insert(key);
+            }
+        }
+    });
+    runVectorSetOperation("std::set_union           ", a, few, set_union<vector<T>::const_iterator, vector<T>::const_iterator, back_insert_iterator<vector<T> > >);
+}
+
+/**
+ * @brief Time a batch update and the matching loop of single updates on copies of the same tree
+ * @param tree the keys of the tree
+ * @param batch the keys to insert or remove
+ * @param insert true to insert the batch, false to remove it
+ */
+void runBatch(const vector<T>& tree, const vector<T>& batch, bool insert) {
+    BST bst;
+    bst.buildFromUnsorted(tree.data(), tree.size());
+    auto start = chrono::steady_clock::now();
+    for (T key : batch) {
+        if (insert) {
+            bst.insert(key);
+        } else {
+            bst.remove(key);
+        }
+    }
+    chrono::duration<double> loop = chrono::steady_clock::now() - start;
+    size_t loopSize = bst.size();
+
+    bst.buildFromUnsorted(tree.data(), tree.size());
+    start = chrono::steady_clock::now();
+    if (insert) {
+        bst.insertBatch(batch.data(), batch.size());
+    } else {
+        bst.removeBatch(batch.data(), batch.size());
+    }
+    chrono::duration<double> batched = chrono::steady_clock::now() - start;
+    assert(bst.size() == loopSize);
+
+    cout << batch.size() << (insert ? " inserts" : " removes") << " into " << tree.size()
+         << ": loop " << loop.count() * 1e3 << " ms, batch " << batched.count() * 1e3 << " ms, "
+         << loop.count() / batched.count() << "x" << endl;
+}
+
+/**
+ * @brief Compare batch updates with loops of single updates. Inserted keys are new and
+ * removed keys are present, so both sides do the same changes.
+ */
+void benchBatch(int n) {
+    mt19937 rng(1);
+    vector<T> keys = shuffledKeys(2 * n, rng);
+    vector<T> tree(keys.begin(), keys.begin() + n);
+    vector<T> fresh(keys.begin() + n, keys.end());
+    vector<T> present = tree;
+    shuffle(present.begin(), present.end(), rng);
+    for (int size : {n, n / 100}) {
+        runBatch(tree, vector<T>(fresh.begin(), fresh.begin() + size), true);
+        runBatch(tree, vector<T>(present.begin(), present.begin() + size), false);
+    }
+}
+
+/**
+ * @brief Run reader threads, and optionally a writer, for a fixed time and print the rates
+ * @param name name of the tree
+ * @param readers number of reader threads
+ * @param withWriter true to run a writer thread as well
+ * @param lookup function taking a key and returning whether it was found, run by the readers
+ * @param update function taking a key and a bool, inserting the key if it is true and removing it otherwise
+ * @param n keys are drawn from [0, 2n)
+ */
+template <typename Lookup, typename Update>
+void runReaders(const char* name, int readers, bool withWriter, Lookup lookup, Update update, int n) {
+    const chrono::milliseconds duration(500);
+    atomic<bool> done(false);
+    atomic<long> lookups(0);
+    long updates = 0;
+    vector<thread> threads;
+    for (int r = 0; r < readers; r++) {
+        threads.push_back(thread([&, r]() {
+            mt19937 rng(r + 1);
+            uniform_int_distribution<T> any(0, 2 * n - 1);
+            long count = 0, found = 0;
+            while (!done.load(memory_order_relaxed)) {
+                found += lookup(any(rng));
+                count++;
+            }
+            lookups += count + (found < 0);
+        }));
+    }
+    if (withWriter) {
+        threads.push_back(thread([&]() {
+            mt19937 rng(0);
+            uniform_int_distribution<T> any(0, 2 * n - 1);
+            while (!done.load(memory_order_relaxed)) {
+                update(any(rng), (updates & 1) == 0);
+                updates++;
+            }
+        }));
+    }
+    this_thread::sleep_for(duration);
+    done.store(true);
+    for (thread& t : threads) {
+        t.join();
+    }
+    double seconds = chrono::duration<double>(duration).count();
+    cout << name << ", " << readers << " reader" << (readers == 1 ? ", " : "s,") << (withWriter ? " writer   " : " no writer")
+         << ": " << lookups / seconds / 1e6 << " M lookups/s";
+    if (withWriter) {
+        cout << ", " << updates / seconds / 1e6 << " M updates/s";
+    }
+    cout << endl;
+}
+
+/**
+ * @brief Compare lock-free snapshot reads of PersistentBST with reads of a BST under a mutex.
+ * Each PersistentBST lookup takes its own snapshot, the worst case for snapshot overhead.
+ */
+void benchSnapshot(int n) {
+    mt19937 rng(1);
+    vector<T> keys = shuffledKeys(2 * n, rng);
+    keys.resize(n);
+    PersistentBST persistent;
+    BST locked;
+    mutex lock;
+    //both trees are built by inserting in the same random order, so their nodes are laid out alike
+    for (T key : keys) {
+        persistent.insert(key);
+        locked.insert(key);
+    }
+
+    cout << n << " keys, " << thread::hardware_concurrency() << " hardware threads" << endl;
+    for (bool withWriter : {false, true}) {
+        for (int readers : {1, 2, 4}) {
+            runReaders("PersistentBST", readers, withWriter,
+                       [&persistent](T key) { return persistent.snapshot().find(key); },
+                       [&persistent](T key, bool insert) { insert ? persistent.insert(key) : persistent.remove(key); }, n);
+            runReaders("BST + mutex  ", readers, withWriter,
+                       [&](T key) {
+                           lock_guard<mutex> guard(lock);
+                           return locked.find(key);
+                       },
+                       [&](T key, bool insert) {
+                           lock_guard<mutex> guard(lock);
+                           if (insert && !locked.find(key)) {
+                               locked.insert(key);
+                           } else if (!insert) {
+                               locked.remove(key);
+                           }
+                       }, n);
+        }
+    }
+}
+
+/**
+ * @brief Time a lookup loop and print nanoseconds per lookup
+ * @param name name of the search
+ * @param queries keys to look up
+ * @param lookup function taking a key and returning a value to add to the checksum
+ */
+template <typename Lookup>
+void runLookups(const char* name, const vector<T>& queries, Lookup lookup) {
+    auto start = chrono::steady_clock::now();
+    long checksum = 0;
+    for (T key : queries) {
+        checksum += lookup(key);
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << name << ": " << elapsed.count() * 1e9 / queries.size() << " ns/lookup (checksum " << checksum << ")" << endl;
+}
+
+/**
+ * @brief Compare lookups in the pointer tree with lookups in its frozen arrays
+ */
+void benchFrozen(long n) {
+    mt19937 rng(1);
+    vector<T> sorted(n);
+    for (long i = 0; i < n; i++) {
+        sorted[i] = 2 * i;
+    }
+    vector<T> queries(10000000);
+    uniform_int_distribution<T> any(0, 2 * n - 1);
+    for (T& key : queries) {
+        key = any(rng);
+    }
+
+    FrozenBST eytzinger, vanEmdeBoas;
+    cout << n << " keys" << endl;
+    if (n <= 30000000) {
+        vector<T> shuffled = sorted;
+        shuffle(shuffled.begin(), shuffled.end(), rng);
+        BST bst;
+        for (T key : shuffled) {
+            bst.insert(key);
+        }
+        runLookups("AVL find, inserted     ", queries, [&bst](T key) { return bst.find(key); });
+        eytzinger = bst.freeze();
+        vanEmdeBoas = bst.freezeVanEmdeBoas();
+        bst.buildFromSorted(sorted.data(), n);
+        runLookups("AVL find, bulk-loaded  ", queries, [&bst](T key) { return bst.find(key); });
+    } else {
+        eytzinger.build(sorted.data(), n, FrozenBST::EYTZINGER);
+        vanEmdeBoas.build(sorted.data(), n, FrozenBST::VAN_EMDE_BOAS);
+    }
+    runLookups("Eytzinger find         ", queries, [&eytzinger](T key) { return eytzinger.find(key); });
+    runLookups("van Emde Boas find     ", queries, [&vanEmdeBoas](T key) { return vanEmdeBoas.find(key); });
+    runLookups("Eytzinger lower_bound  ", queries, [&eytzinger](T key) {
+        const T* found = eytzinger.lower_bound(key);
+        return found ? *found : -1;
+    });
+    runLookups("std::lower_bound       ", queries, [&sorted](T key) {
+        vector<T>::const_iterator found = lower_bound(sorted.begin(), sorted.end(), key);
+        return found != sorted.end() ? *found : -1;
+    });
+}
+
+/**
+ * @brief Time inserts, lookups and scans of one tree type and print the rates
+ * @param name name of the tree
+ * @param keys distinct keys in insertion order
+ * @param queries keys to look up, half of them missing
+ */
+template <typename Tree>
+void runTree(const char* name, const vector<T>& keys, const vector<T>& queries) {
+    Tree tree;
+    auto start = chrono::steady_clock::now();
+    for (T key : keys) {
+        tree.insert(key);
+    }
+    chrono::duration<double> insert = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    long found = 0;
+    for (T key : queries) {
+        found += tree.find(key);
+    }
+    chrono::duration<double> lookup = chrono::steady_clock::now() - start;
+
+    const int scans = 5;
+    start = chrono::steady_clock::now();
+    long sum = 0;
+    for (int i = 0; i < scans; i++) {
+        for (T element : tree) {
+            sum += element;
+        }
+    }
+    chrono::duration<double> scan = chrono::steady_clock::now() - start;
+
+    cout << name << ": insert " << keys.size() / insert.count() / 1e6 << " M/s, find "
+         << queries.size() / lookup.count() / 1e6 << " M/s, scan " << scans * keys.size() / scan.count() / 1e6
+         << " M elements/s, height " << tree.height() << " (checksum " << found + sum << ")" << endl;
+}
+
+/**
+ * @brief Compare the AVL tree with B+-trees of different node sizes
+ */
+void benchBPlusTree(int n) {
+    mt19937 rng(1);
+    vector<T> keys = shuffledKeys(2 * n, rng);
+    vector<T> queries(keys.begin(), keys.begin() + n);
+    keys.resize(n);
+    shuffle(queries.begin(), queries.end(), rng);
+
+    cout << n << " keys" << endl;
+    runTree<BST>("AVL             ", keys, queries);
+    runTree<BPlusTree<1> >("B+-tree, 1 line ", keys, queries);
+    runTree<BPlusTree<2> >("B+-tree, 2 lines", keys, queries);
+    runTree<BPlusTree<4> >("B+-tree, 4 lines", keys, queries);
+}
+
+/**
+ * @brief Read whitespace-separated keys from a text file
+ */
+vector<T> readDump(const char* path) {
+    vector<T> keys;
+    FILE* input = fopen(path, "r");
+    T key;
+    while (fscanf(input, "%d", &key) == 1) {
+        keys.push_back(key);
+    }
+    fclose(input);
+    return keys;
+}
+
+/**
+ * @brief Drop the pages of a file from the page cache, so that the next read comes from the disk
+ */
+void dropCache(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+/**
+ * @brief Compare ways of getting a searchable set of n keys after a restart. Each is timed
+ * from nothing in memory until 1000 random lookups have been answered.
+ */
+void benchStartup(int n) {
+    const char* dumpPath = "startup.txt";
+    const char* mappedPath = "startup.bst";
+    mt19937 rng(1);
+    vector<T> keys = shuffledKeys(n, rng);
+    vector<T> queries(keys.begin(), keys.begin() + 1000);
+    FILE* dump = fopen(dumpPath, "w");
+    for (T key : keys) {
+        fprintf(dump, "%d\n", key);
+    }
+    fclose(dump);
+
+    cout << n << " keys" << endl;
+    long found;
+    {
+        auto start = chrono::steady_clock::now();
+        vector<T> dumped = readDump(dumpPath);
+        chrono::duration<double> read = chrono::steady_clock::now() - start;
+        BST bst;
+        for (T key : dumped) {
+            bst.insert(key);
+        }
+        found = 0;
+        for (T key : queries) {
+            found += bst.find(key);
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        cout << "text dump + insert loop      : " << elapsed.count() * 1e3 << " ms (" << read.count() * 1e3
+             << " ms reading, found " << found << ")" << endl;
+
+        start = chrono::steady_clock::now();
+        dumped = readDump(dumpPath);
+        BST bulk;
+        bulk.buildFromUnsorted(dumped.data(), dumped.size());
+        found = 0;
+        for (T key : queries) {
+            found += bulk.find(key);
+        }
+        elapsed = chrono::steady_clock::now() - start;
+        cout << "text dump + buildFromUnsorted: " << elapsed.count() * 1e3 << " ms (found " << found << ")" << endl;
+
+        start = chrono::steady_clock::now();
+        bool saved = MappedBST::save(bst.freeze(), mappedPath) && MappedBST::save(bst.freezeVanEmdeBoas(), "startup.veb");
+        elapsed = chrono::steady_clock::now() - start;
+        assert(saved);
+        cout << "freeze + save, both layouts  : " << elapsed.count() * 1e3 << " ms" << endl;
+    }
+
+    const char* paths[] = {mappedPath, "startup.veb"};
+    const char* names[] = {"mmap Eytzinger file          ", "mmap van Emde Boas file      "};
+    for (int i = 0; i < 2; i++) {
+        dropCache(paths[i]);
+        long before = residentBytes();
+        auto start = chrono::steady_clock::now();
+        MappedBST mapped;
+        bool opened = mapped.open(paths[i]);
+        chrono::duration<double> open = chrono::steady_clock::now() - start;
+        assert(opened);
+        found = 0;
+        for (T key : queries) {
+            found += mapped.find(key);
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        cout << names[i] << ": " << elapsed.count() * 1e3 << " ms (" << open.count() * 1e6 << " us in open, "
+             << (residentBytes() - before) / 1024 << " KB of " << mapped.mappedBytes() / 1024
+             << " KB paged in, found " << found << ")" << endl;
+    }
+    remove(dumpPath);
+    remove(mappedPath);
+    remove("startup.veb");
+}
+
+/**
+ * @brief Time inserts, lookups, scans and removes of one map type and print the rates
+ * @param name name of the map
+ * @param keys distinct keys in insertion order
+ * @param queries keys to look up, half of them missing
+ * @param insert function inserting a key and value into the map
+ * @param find function returning a pointer to a key's value, nullptr if missing
+ * @param scan function returning the sum of all values in key order
+ * @param remove function removing a key
+ */
+template <typename Map, typename Insert, typename Find, typename Scan, typename Remove>
+void runMap(const char* name, const vector<T>& keys, const vector<T>& queries,
+            Insert insert, Find find, Scan scan, Remove remove) {
+    //each map runs in its own process, so neither gets the other's freed nodes back from malloc in random order
+    pid_t child = fork();
+    if (child != 0) {
+        waitpid(child, nullptr, 0);
+        return;
+    }
+    Map map;
+    auto start = chrono::steady_clock::now();
+    for (T key : keys) {
+        insert(map, key, key / 2);
+    }
+    chrono::duration<double> insertTime = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    long sum = 0;
+    for (T key : queries) {
+        const int* value = find(map, key);
+        sum += value ? *value : 0;
+    }
+    chrono::duration<double> lookup = chrono::steady_clock::now() - start;
+
+    const int scans = 5;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < scans; i++) {
+        sum += scan(map);
+    }
+    chrono::duration<double> scanTime = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (T key : queries) {
+        remove(map, key);
+    }
+    chrono::duration<double> removeTime = chrono::steady_clock::now() - start;
+
+    cout << name << ": insert " << keys.size() / insertTime.count() / 1e6 << " M/s, find "
+         << queries.size() / lookup.count() / 1e6 << " M/s, scan " << scans * keys.size() / scanTime.count() / 1e6
+         << " M entries/s, remove " << queries.size() / removeTime.count() / 1e6 << " M/s (checksum "
+         << sum << ")" << endl;
+    exit(0);
+}
+
+/**
+ * @brief Compare Map with std::map
+ */
+void benchMap(int n) {
+    mt19937 rng(1);
+    vector<T> keys = shuffledKeys(2 * n, rng);
+    vector<T> queries(keys.begin(), keys.begin() + n);
+    keys.resize(n);
+    shuffle(queries.begin(), queries.end(), rng);
+
+    cout << n << " keys" << endl;
+    runMap<std::map<int, int> >("std::map", keys, queries,
+        [](std::map<int, int>& m, int key, int value) { m.insert(make_pair(key, value)); },
+        [](std::map<int, int>& m, int key) {
+            std::map<int, int>::const_iterator it = m.find(key);
+            return it == m.end() ? (const int*)nullptr : &it->second;
+        },
+        [](std::map<int, int>& m) {
+            long sum = 0;
+            for (const pair<const int, int>& entry : m) {
+                sum += entry.second;
+            }
+            return sum;
+        },
+        [](std::map<int, int>& m, int key) { m.erase(key); });
+    runMap<Map<int, int> >("Map     ", keys, queries,
+        [](Map<int, int>& m, int key, int value) { m.insert(key, value); },
+        [](Map<int, int>& m, int key) { return (const int*)m.find(key); },
+        [](Map<int, int>& m) {
+            long sum = 0;
+            for (const Map<int, int>::Node& entry : m) {
+                sum += entry.value;
+            }
+            return sum;
+        },
+        [](Map<int, int>& m, int key) { m.remove(key); });
+}
+
+/**
+ * @brief Time inserting a stream and then finding it again, from the root and from a finger
+ * @param name name of the stream
+ * @param keys the stream
+ */
+void runFinger(const char* name, const vector<T>& keys) {
+    //the first tree built takes fresh pages from the system, so a throwaway one goes first
+    //and both timed trees get their nodes from the memory it gave back
+    {
+        BST warmup;
+        warmup.buildFromUnsorted(keys.data(), keys.size());
+    }
+    long found = 0;
+    chrono::duration<double> insert, fingerInsert, find, fingerFind;
+    {
+        BST plain;
+        auto start = chrono::steady_clock::now();
+        for (T key : keys) {
+            plain.insert(key);
+        }
+        insert = chrono::steady_clock::now() - start;
+        start = chrono::steady_clock::now();
+        for (T key : keys) {
+            found += plain.find(key);
+        }
+        find = chrono::steady_clock::now() - start;
+    }
+    {
+        BST fingered;
+        BST::Node* finger = nullptr;
+        auto start = chrono::steady_clock::now();
+        for (T key : keys) {
+            fingered.insert(key, finger);
+        }
+        fingerInsert = chrono::steady_clock::now() - start;
+        finger = nullptr;
+        start = chrono::steady_clock::now();
+        for (T key : keys) {
+            found += fingered.find(key, finger);
+        }
+        fingerFind = chrono::steady_clock::now() - start;
+    }
+
+    cout << name << ": insert " << insert.count() * 1e9 / keys.size() << " ns, with finger "
+         << fingerInsert.count() * 1e9 / keys.size() << " ns; find " << find.count() * 1e9 / keys.size()
+         << " ns, with finger " << fingerFind.count() * 1e9 / keys.size() << " ns (found " << found << ")" << endl;
+}
+
+/**
+ * @brief Compare searches from the root and from a finger on streams with more or less locality
+ */
+void benchFinger(int n) {
+    mt19937 rng(1);
+    vector<T> keys(n);
+    for (int i = 0; i < n; i++) {
+        keys[i] = i;
+    }
+    cout << n << " keys" << endl;
+    runFinger("sorted       ", keys);
+    uniform_int_distribution<int> near(0, 16);
+    uniform_int_distribution<int> any(0, n - 1);
+    for (int i = 0; i + 16 < n; i++) {
+        swap(keys[i], keys[i + near(rng)]);
+        if (i % 100 == 0) {
+            swap(keys[i], keys[any(rng)]);
+        }
+    }
+    runFinger("nearly sorted", keys);
+    shuffle(keys.begin(), keys.end(), rng);
+    runFinger("random       ", keys);
+}
+
+int main(int argc, char *argv[])
+{
+    string name = argc > 1 ? argv[1] : "";
+    int n = argc > 2 ? atoi(argv[2]) : 0;
+    if (name == "arena") {
+        benchArena(n > 0 ? n : 10000000);
+    } else if (name == "build") {
+        benchBuild(n > 0 ? n : 1000000);
+    } else if (name == "retrace") {
+        benchRetrace(n > 0 ? n : 1000000);
+    } else if (name == "order") {
+        benchOrder(n > 0 ? n : 1000000);
+    } else if (name == "scan") {
+        benchScan(n > 0 ? n : 1000000);
+    } else if (name == "setops") {
+        benchSetOperations(n > 0 ? n : 10000000);
+    } else if (name == "batch") {
+        benchBatch(n > 0 ? n : 1000000);
+    } else if (name == "frozen") {
+        if (n > 0) {
+            benchFrozen(n);
+        } else {
+            benchFrozen(1000000);
+            benchFrozen(10000000);
+        }
+    } else if (name == "btree") {
+        benchBPlusTree(n > 0 ? n : 10000000);
+    } else if (name == "finger") {
+        benchFinger(n > 0 ? n : 1000000);
+    } else if (name == "map") {
+        benchMap(n > 0 ? n : 1000000);
+    } else if (name == "startup") {
+        benchStartup(n > 0 ? n : 10000000);
+    } else if (name == "snapshot") {
+        benchSnapshot(n > 0 ? n : 1000000);
+    } else {
+        cerr << "Usage: " << argv[0] << " <arena|build|retrace|order|scan|setops|batch|snapshot|frozen|btree|startup|map|finger> [number of keys]" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,774 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file bplus_tree.h
+// @brief This class defines a B+-tree with cache-line-sized nodes
+//=======================================================
+//
+// The AVL tree keeps one key per node, so a search makes about 1.44 log2 n
+// dependent pointer loads, each a likely cache miss once the tree outgrows the
+// cache. A B+-tree node holds the keys of LINES whole cache lines (16 ints per
+// line), so a node costs a few adjacent misses and the tree is only about
+// log_17 n to log_65 n levels deep. Inside a node the keys are compared with
+// the search key four at a time with SSE2, and the number of smaller keys,
+// which is the child or slot to take, is a popcount of the comparison masks.
+// All elements live in the leaves, which are linked in order, so a scan walks
+// along the leaves without going back up the tree.
+//
+// It is a template on LINES so one to four lines can be compared; the whole
+// class is in this header.
+
+#ifndef ASSIGN_5E_BPLUS_TREE_H
+#define ASSIGN_5E_BPLUS_TREE_H
+
+#include "BST.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Count the keys[0, n) that are less than key, or not greater than key if orEqual
+ * @param keys a node's key array, at least n rounded up to a multiple of 4 long
+ * @param n number of keys in use, at most 64
+ */
+template <typename Key>
+inline int countLess(const Key *keys, int n, const Key &key, bool orEqual)
+{
+    int count = 0;
+    for (int i = 0; i < n; i++)
+    {
+        count += orEqual ? !(key < keys[i]) : keys[i] < key;
+    }
+    return count;
+}
+
+#ifdef __SSE2__
+/**
+ * @brief SSE2 version for int keys: compare four keys per instruction, collect one bit per key
+ * in a mask, and count the bits of the keys in use
+ */
+template <>
+inline int countLess<int>(const int *keys, int n, const int &key, bool orEqual)
+{
+    //keys[i] <= key is keys[i] < key + 1, except that key + 1 overflows for the largest int
+    if (orEqual && key == INT32_MAX)
+    {
+        return n;
+    }
+    __m128i probe = _mm_set1_epi32(orEqual ? key + 1 : key);
+    uint64_t mask = 0;
+    for (int i = 0; i < n; i += 4)
+    {
+        __m128i block = _mm_load_si128(reinterpret_cast<const __m128i *>(keys + i));
+        uint64_t bits = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(block, probe)));
+        mask |= bits << i;
+    }
+    if (n < 64)
+    {
+        mask &= (uint64_t(1) << n) - 1;
+    }
+    return __builtin_popcountll(mask);
+}
+#endif
+
+/**
+ * B+-tree set whose nodes hold the keys of LINES cache lines
+ */
+template <int LINES = 2>
+class BPlusTree
+{
+public:
+    /**
+     * Keys per node, which fill LINES cache lines
+     */
+    static const int KEYS = LINES * 64 / sizeof(T);
+
+    /**
+     * Fewest keys a node other than the root may hold
+     */
+    static const int MIN_KEYS = KEYS / 2;
+
+    /**
+     * Common part of inner nodes and leaves. The tree knows its height, so nodes carry no type.
+     */
+    struct alignas(64) Node
+    {
+        T keys[KEYS];
+        int count;
+
+        Node() : count(0)
+        {
+            for (int i = 0; i < KEYS; i++)
+            {
+                keys[i] = T();
+            }
+        }
+
+        //new before C++17 does not honor alignas beyond 16 bytes, so nodes allocate their own lines
+        static void *operator new(size_t bytes)
+        {
+            void *memory = nullptr;
+            if (posix_memalign(&memory, 64, bytes) != 0)
+            {
+                throw std::bad_alloc();
+            }
+            return memory;
+        }
+        static void operator delete(void *memory) { free(memory); }
+    };
+
+    /**
+     * Inner node. keys[i] is the smallest element under children[i + 1].
+     */
+    struct Inner : Node
+    {
+        Node *children[KEYS + 1];
+    };
+
+    /**
+     * Leaf node holding count elements in ascending order
+     */
+    struct Leaf : Node
+    {
+        Leaf *next;
+
+        Leaf() : next(nullptr) {}
+    };
+
+    /**
+     * Read-only iterator over the elements in ascending order, along the linked leaves
+     */
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        /**
+         * @brief Iterator constructor
+         * @param leaf the leaf to start at, nullptr for the end
+         * @param index position in the leaf
+         */
+        Iterator(Leaf *leaf = nullptr, int index = 0) : leaf(leaf), index(index) {}
+
+        const T &operator*() const { return leaf->keys[index]; }
+        const T *operator->() const { return &leaf->keys[index]; }
+
+        /**
+         * @brief Move to the next element in ascending order
+         */
+        Iterator &operator++()
+        {
+            if (++index == leaf->count)
+            {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const Iterator &other) const { return leaf == other.leaf && index == other.index; }
+        bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+    private:
+        Leaf *leaf;
+        int index;
+    };
+
+    /**
+     * BPlusTree Constructor, which initializes an empty tree
+     */
+    BPlusTree() : root(nullptr), levels(0), numElements(0) {}
+
+    /**
+     * BPlusTree Destructor, which frees every node
+     */
+    ~BPlusTree() { clear(); }
+
+    /**
+     * @brief Find a query element
+     * @param query The query element to find
+     * @return true if query exists in this tree, otherwise false
+     */
+    bool find(const T &query) const;
+
+    /**
+     * @brief Insert a new element
+     * @param element The new element to insert
+     * @return true if the insertion was successful, false if element is already in the tree
+     */
+    bool insert(T element);
+
+    /**
+     * @brief Remove an element, borrowing from or merging with a sibling when a node gets less than half full
+     * @param element The element to remove
+     * @return true if the removal was successful, false if element was not found
+     */
+    bool remove(T element);
+
+    /**
+     * @brief Remove all elements and free every node
+     */
+    void clear();
+
+    /**
+     * @brief Return the number of elements in the tree
+     */
+    unsigned int size() const { return numElements; }
+
+    /**
+     * @brief Return the number of levels, 0 for an empty tree and 1 for a single leaf
+     */
+    int height() const { return levels; }
+
+    /**
+     * @brief Return the root node, nullptr if the tree is empty
+     */
+    const Node *getRoot() const { return root; }
+
+    /**
+     * @brief Return an iterator to the smallest element
+     */
+    Iterator begin() const;
+
+    /**
+     * @brief Return the iterator past the largest element
+     */
+    Iterator end() const { return Iterator(); }
+
+    /**
+     * @brief Find the first element that is not less than key
+     * @param key the key to search for
+     * @return iterator to the element, end() if every element is less than key
+     */
+    Iterator lower_bound(const T &key) const;
+
+    /**
+     * @brief Call callback on every element e with lo <= e <= hi, in ascending order
+     * @param lo lower bound of the range
+     * @param hi upper bound of the range
+     * @param callback function taking a const T&
+     * @return the number of elements passed to callback
+     */
+    template <typename Callback>
+    unsigned int rangeScan(const T &lo, const T &hi, Callback callback) const;
+
+private:
+    Node *root;
+
+    /**
+     * Number of levels; nodes on the last level are leaves
+     */
+    int levels;
+
+    unsigned int numElements;
+
+    /**
+     * A node split off while inserting, and the smallest element under it
+     */
+    struct Split
+    {
+        T separator;
+        Node *right;
+    };
+
+    bool insert(Node *node, int depth, const T &element, Split &split);
+    bool remove(Node *node, int depth, const T &element);
+    void fixChild(Inner *parent, int c, bool leaves);
+    void clear(Node *node, int depth);
+    Leaf *findLeaf(const T &key) const;
+};
+
+/**
+ * @brief Walk down to the leaf that holds key or would hold it
+ * @param key the key to search for
+ * @return the leaf, nullptr if the tree is empty
+ */
+template <int LINES>
+typename BPlusTree<LINES>::Leaf *BPlusTree<LINES>::findLeaf(const T &key) const
+{
+    Node *node = root;
+    for (int depth = 1; depth < levels; depth++)
+    {
+        Inner *inner = static_cast<Inner *>(node);
+        node = inner->children[countLess(inner->keys, inner->count, key, true)];
+    }
+    return static_cast<Leaf *>(node);
+}
+
+/**
+ * @brief Find a query element
+ * @param query The query element to find
+ * @return true if query exists in this tree, otherwise false
+ */
+template <int LINES>
+bool BPlusTree<LINES>::find(const T &query) const
+{
+    Leaf *leaf = findLeaf(query);
+    if (leaf == nullptr)
+    {
+        return false;
+    }
+    int i = countLess(leaf->keys, leaf->count, query, false);
+    return i < leaf->count && !(query < leaf->keys[i]);
+}
+
+/**
+ * @brief Return an iterator to the smallest element
+ */
+template <int LINES>
+typename BPlusTree<LINES>::Iterator BPlusTree<LINES>::begin() const
+{
+    Node *node = root;
+    if (node == nullptr)
+    {
+        return end();
+    }
+    for (int depth = 1; depth < levels; depth++)
+    {
+        node = static_cast<Inner *>(node)->children[0];
+    }
+    return Iterator(static_cast<Leaf *>(node), 0);
+}
+
+/**
+ * @brief Find the first element that is not less than key
+ * @param key the key to search for
+ * @return iterator to the element, end() if every element is less than key
+ */
+template <int LINES>
+typename BPlusTree<LINES>::Iterator BPlusTree<LINES>::lower_bound(const T &key) const
+{
+    Leaf *leaf = findLeaf(key);
+    if (leaf == nullptr)
+    {
+        return end();
+    }
+    int i = countLess(leaf->keys, leaf->count, key, false);
+    if (i == leaf->count)
+    {
+        //every element of this leaf is less than key, so the answer starts the next leaf
+        return Iterator(leaf->next, 0);
+    }
+    return Iterator(leaf, i);
+}
+
+/**
+ * @brief Call callback on every element e with lo <= e <= hi, in ascending order
+ * @param lo lower bound of the range
+ * @param hi upper bound of the range
+ * @param callback function taking a const T&
+ * @return the number of elements passed to callback
+ */
+template <int LINES>
+template <typename Callback>
+unsigned int BPlusTree<LINES>::rangeScan(const T &lo, const T &hi, Callback callback) const
+{
+    unsigned int count = 0;
+    for (Iterator it = lower_bound(lo); it != end() && !(hi < *it); ++it)
+    {
+        callback(*it);
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Insert a new element
+ * @param element The new element to insert
+ * @return true if the insertion was successful, false if element is already in the tree
+ */
+template <int LINES>
+bool BPlusTree<LINES>::insert(T element)
+{
+    if (root == nullptr)
+    {
+        root = new Leaf();
+        levels = 1;
+    }
+    Split split;
+    split.right = nullptr;
+    if (!insert(root, 1, element, split))
+    {
+        return false;
+    }
+    if (split.right != nullptr)
+    {
+        //the root split: the tree grows a level at the top
+        Inner *newRoot = new Inner();
+        newRoot->count = 1;
+        newRoot->keys[0] = split.separator;
+        newRoot->children[0] = root;
+        newRoot->children[1] = split.right;
+        root = newRoot;
+        levels++;
+    }
+    numElements++;
+    return true;
+}
+
+/**
+ * @brief Insert into a subtree. A full node is split in half, and the right half is passed
+ * up with its smallest element for the parent to add.
+ * @param node the subtree root
+ * @param depth level of node, 1 for the root
+ * @param element the element to insert
+ * @param split gets the new right sibling of node if node split, otherwise split.right stays nullptr
+ * @return false if element is already in the subtree
+ */
+template <int LINES>
+bool BPlusTree<LINES>::insert(Node *node, int depth, const T &element, Split &split)
+{
+    if (depth == levels)
+    {
+        Leaf *leaf = static_cast<Leaf *>(node);
+        int i = countLess(leaf->keys, leaf->count, element, false);
+        if (i < leaf->count && !(element < leaf->keys[i]))
+        {
+            return false;
+        }
+        if (leaf->count == KEYS)
+        {
+            //move the upper half to a new leaf and insert into whichever half element belongs to
+            Leaf *right = new Leaf();
+            right->count = KEYS - MIN_KEYS;
+            for (int j = 0; j < right->count; j++)
+            {
+                right->keys[j] = leaf->keys[MIN_KEYS + j];
+            }
+            leaf->count = MIN_KEYS;
+            right->next = leaf->next;
+            leaf->next = right;
+            if (i > MIN_KEYS)
+            {
+                leaf = right;
+                i -= MIN_KEYS;
+            }
+            split.right = right;
+        }
+        for (int j = leaf->count; j > i; j--)
+        {
+            leaf->keys[j] = leaf->keys[j - 1];
+        }
+        leaf->keys[i] = element;
+        leaf->count++;
+        if (split.right != nullptr)
+        {
+            split.separator = static_cast<Leaf *>(split.right)->keys[0];
+        }
+        return true;
+    }
+
+    Inner *inner = static_cast<Inner *>(node);
+    int c = countLess(inner->keys, inner->count, element, true);
+    Split childSplit;
+    childSplit.right = nullptr;
+    if (!insert(inner->children[c], depth + 1, element, childSplit))
+    {
+        return false;
+    }
+    if (childSplit.right == nullptr)
+    {
+        return true;
+    }
+    //add the child's new sibling after it: key at c, child at c + 1
+    T keys[KEYS + 1];
+    Node *children[KEYS + 2];
+    int n = inner->count;
+    for (int j = 0, k = 0; j <= n; j++)
+    {
+        if (j == c)
+        {
+            keys[k++] = childSplit.separator;
+        }
+        if (j < n)
+        {
+            keys[k++] = inner->keys[j];
+        }
+    }
+    for (int j = 0, k = 0; j <= n; j++)
+    {
+        children[k++] = inner->children[j];
+        if (j == c)
+        {
+            children[k++] = childSplit.right;
+        }
+    }
+    n++;
+    if (n <= KEYS)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            inner->keys[j] = keys[j];
+        }
+        for (int j = 0; j <= n; j++)
+        {
+            inner->children[j] = children[j];
+        }
+        inner->count = n;
+        return true;
+    }
+    //split: the middle key moves up, the keys after it go to the new right node
+    int middle = n / 2;
+    Inner *right = new Inner();
+    inner->count = middle;
+    for (int j = 0; j < middle; j++)
+    {
+        inner->keys[j] = keys[j];
+    }
+    for (int j = 0; j <= middle; j++)
+    {
+        inner->children[j] = children[j];
+    }
+    right->count = n - middle - 1;
+    for (int j = 0; j < right->count; j++)
+    {
+        right->keys[j] = keys[middle + 1 + j];
+    }
+    for (int j = 0; j <= right->count; j++)
+    {
+        right->children[j] = children[middle + 1 + j];
+    }
+    split.separator = keys[middle];
+    split.right = right;
+    return true;
+}
+
+/**
+ * @brief Remove an element
+ * @param element The element to remove
+ * @return true if the removal was successful, false if element was not found
+ */
+template <int LINES>
+bool BPlusTree<LINES>::remove(T element)
+{
+    if (root == nullptr || !remove(root, 1, element))
+    {
+        return false;
+    }
+    numElements--;
+    if (levels > 1 && root->count == 0)
+    {
+        //the root's last two children merged: its only child becomes the root
+        Inner *oldRoot = static_cast<Inner *>(root);
+        root = oldRoot->children[0];
+        delete oldRoot;
+        levels--;
+    }
+    else if (levels == 1 && root->count == 0)
+    {
+        delete static_cast<Leaf *>(root);
+        root = nullptr;
+        levels = 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Remove from a subtree, fixing any child left with fewer than MIN_KEYS keys
+ * @param node the subtree root
+ * @param depth level of node, 1 for the root
+ * @param element the element to remove
+ * @return true if element was found
+ */
+template <int LINES>
+bool BPlusTree<LINES>::remove(Node *node, int depth, const T &element)
+{
+    if (depth == levels)
+    {
+        int i = countLess(node->keys, node->count, element, false);
+        if (i == node->count || element < node->keys[i])
+        {
+            return false;
+        }
+        node->count--;
+        for (int j = i; j < node->count; j++)
+        {
+            node->keys[j] = node->keys[j + 1];
+        }
+        return true;
+    }
+    Inner *inner = static_cast<Inner *>(node);
+    int c = countLess(inner->keys, inner->count, element, true);
+    if (!remove(inner->children[c], depth + 1, element))
+    {
+        return false;
+    }
+    if (inner->children[c]->count < MIN_KEYS)
+    {
+        fixChild(inner, c, depth + 1 == levels);
+    }
+    return true;
+}
+
+/**
+ * @brief Refill a child that has fewer than MIN_KEYS keys, from a sibling that can spare
+ * one or else by merging it with a sibling
+ * @param parent the parent of the child
+ * @param c index of the child in parent
+ * @param leaves true if the child and its siblings are leaves
+ */
+template <int LINES>
+void BPlusTree<LINES>::fixChild(Inner *parent, int c, bool leaves)
+{
+    Node *child = parent->children[c];
+    Node *left = c > 0 ? parent->children[c - 1] : nullptr;
+    Node *right = c < parent->count ? parent->children[c + 1] : nullptr;
+
+    if (left != nullptr && left->count > MIN_KEYS)
+    {
+        //borrow the left sibling's largest key
+        for (int j = child->count; j > 0; j--)
+        {
+            child->keys[j] = child->keys[j - 1];
+        }
+        if (leaves)
+        {
+            child->keys[0] = left->keys[left->count - 1];
+            parent->keys[c - 1] = child->keys[0];
+        }
+        else
+        {
+            Inner *innerChild = static_cast<Inner *>(child);
+            Inner *innerLeft = static_cast<Inner *>(left);
+            for (int j = child->count + 1; j > 0; j--)
+            {
+                innerChild->children[j] = innerChild->children[j - 1];
+            }
+            innerChild->keys[0] = parent->keys[c - 1];
+            innerChild->children[0] = innerLeft->children[left->count];
+            parent->keys[c - 1] = left->keys[left->count - 1];
+        }
+        child->count++;
+        left->count--;
+        return;
+    }
+    if (right != nullptr && right->count > MIN_KEYS)
+    {
+        //borrow the right sibling's smallest key
+        if (leaves)
+        {
+            child->keys[child->count] = right->keys[0];
+            parent->keys[c] = right->keys[1];
+        }
+        else
+        {
+            Inner *innerChild = static_cast<Inner *>(child);
+            Inner *innerRight = static_cast<Inner *>(right);
+            innerChild->keys[child->count] = parent->keys[c];
+            innerChild->children[child->count + 1] = innerRight->children[0];
+            parent->keys[c] = right->keys[0];
+            for (int j = 0; j < right->count; j++)
+            {
+                innerRight->children[j] = innerRight->children[j + 1];
+            }
+        }
+        for (int j = 0; j < right->count - 1; j++)
+        {
+            right->keys[j] = right->keys[j + 1];
+        }
+        child->count++;
+        right->count--;
+        return;
+    }
+
+    //neither sibling can spare a key: merge the child with one of them, the right one into the left one
+    if (left != nullptr)
+    {
+        right = child;
+        c--;
+    }
+    else
+    {
+        left = child;
+    }
+    if (leaves)
+    {
+        for (int j = 0; j < right->count; j++)
+        {
+            left->keys[left->count + j] = right->keys[j];
+        }
+        left->count += right->count;
+        static_cast<Leaf *>(left)->next = static_cast<Leaf *>(right)->next;
+        delete static_cast<Leaf *>(right);
+    }
+    else
+    {
+        Inner *innerLeft = static_cast<Inner *>(left);
+        Inner *innerRight = static_cast<Inner *>(right);
+        innerLeft->keys[left->count] = parent->keys[c];
+        for (int j = 0; j < right->count; j++)
+        {
+            innerLeft->keys[left->count + 1 + j] = right->keys[j];
+        }
+        for (int j = 0; j <= right->count; j++)
+        {
+            innerLeft->children[left->count + 1 + j] = innerRight->children[j];
+        }
+        left->count += right->count + 1;
+        delete innerRight;
+    }
+    //drop the separator and the pointer to the merged-away node from the parent
+    for (int j = c; j < parent->count - 1; j++)
+    {
+        parent->keys[j] = parent->keys[j + 1];
+    }
+    for (int j = c + 1; j < parent->count; j++)
+    {
+        parent->children[j] = parent->children[j + 1];
+    }
+    parent->count--;
+}
+
+/**
+ * @brief Remove all elements and free every node
+ */
+template <int LINES>
+void BPlusTree<LINES>::clear()
+{
+    if (root != nullptr)
+    {
+        clear(root, 1);
+    }
+    root = nullptr;
+    levels = 0;
+    numElements = 0;
+}
+
+/**
+ * @brief Free every node of a subtree
+ * @param node the subtree root
+ * @param depth level of node, 1 for the root
+ */
+template <int LINES>
+void BPlusTree<LINES>::clear(Node *node, int depth)
+{
+    if (depth == levels)
+    {
+        delete static_cast<Leaf *>(node);
+        return;
+    }
+    Inner *inner = static_cast<Inner *>(node);
+    for (int j = 0; j <= inner->count; j++)
+    {
+        clear(inner->children[j], depth + 1);
+    }
+    delete inner;
+}
+
+#endif // ASSIGN_5E_BPLUS_TREE_H
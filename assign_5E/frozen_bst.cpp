@@ -0,0 +1,225 @@
+/**
+ * Implementation of FrozenBST class.
+ */
+
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: cpp file frozen_bst.cpp
+// @brief This class implements a read-only search array exported from a BST
+//=======================================================
+
+#include "frozen_bst.h"
+#include <cstdint>
+
+// Elements per 64-byte cache line
+static const size_t LINE = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+
+/**
+ * @brief FrozenBST default constructor. An empty Eytzinger array.
+ */
+FrozenBST::FrozenBST() : arrayLayout(EYTZINGER), numElements(0), offset(0), external(nullptr), levels(0) {
+}
+
+/**
+ * @brief Replace the contents with the given elements
+ * @param sorted elements in ascending order
+ * @param n number of elements
+ * @param layout the array layout to use
+ */
+void FrozenBST::build(const T *sorted, size_t n, Layout layout) {
+    arrayLayout = layout;
+    numElements = n;
+    std::vector<T>().swap(storage);
+    offset = 0;
+    external = nullptr;
+    levels = 0;
+    if(layout == EYTZINGER){
+        //elements[0] is unused; place the array so that elements[LINE] starts a cache line
+        storage.resize(n + 1 + LINE);
+        uintptr_t address = reinterpret_cast<uintptr_t>(storage.data());
+        offset = ((64 - address % 64) % 64) / sizeof(T);
+        size_t next = 0;
+        buildEytzinger(storage.data() + offset, sorted, next, 1);
+    }
+    else{
+        buildVanEmdeBoas(sorted, n);
+    }
+}
+
+/**
+ * @brief Fill the Eytzinger subtree at k by an in-order walk, which visits its positions in sorted order
+ * @param elements the 1-based layout array
+ * @param sorted the elements
+ * @param next index of the next element of sorted to place
+ * @param k position of the subtree root
+ */
+void FrozenBST::buildEytzinger(T *elements, const T *sorted, size_t &next, size_t k) {
+    if(k <= numElements){
+        buildEytzinger(elements, sorted, next, 2 * k);
+        elements[k] = sorted[next++];
+        buildEytzinger(elements, sorted, next, 2 * k + 1);
+    }
+}
+
+/**
+ * @brief Set the number of levels of the padded van Emde Boas tree for n elements and fill its navigation tables
+ * @param n number of elements
+ */
+void FrozenBST::setLevels(size_t n) {
+    levels = 0;
+    while((((size_t)1 << levels) - 1) < n){
+        levels++;
+    }
+    topSize.assign(levels, 0);
+    bottomSize.assign(levels, 0);
+    topDepth.assign(levels, 0);
+    splitLevels(0, levels);
+}
+
+/**
+ * @brief Return the number of elements in array(). An empty set has no array at all.
+ */
+size_t FrozenBST::arrayLength() const {
+    if(arrayLayout == EYTZINGER){
+        return numElements == 0 ? 0 : numElements + 1;
+    }
+    return ((size_t)1 << levels) - 1;
+}
+
+/**
+ * @brief Search an array written from array() elsewhere, without copying it
+ * @param elements the layout array
+ * @param n number of elements in the set
+ * @param layout the layout of the array
+ */
+void FrozenBST::view(const T *elements, size_t n, Layout layout) {
+    std::vector<T>().swap(storage);
+    offset = 0;
+    external = elements;
+    arrayLayout = layout;
+    numElements = n;
+    levels = 0;
+    if(layout == VAN_EMDE_BOAS){
+        setLevels(n);
+    }
+}
+
+/**
+ * @brief Fill the navigation tables for the levels [depth, depth + height) of a recursive subtree.
+ * The top tree takes the upper half of the levels, rounded down, and the bottom trees the rest.
+ * @param depth level of the subtree root
+ * @param height number of levels of the subtree
+ */
+void FrozenBST::splitLevels(int depth, int height) {
+    if(height <= 1){
+        return;
+    }
+    int topHeight = height / 2;
+    int bottomLevel = depth + topHeight;
+    topSize[bottomLevel] = ((size_t)1 << topHeight) - 1;
+    bottomSize[bottomLevel] = ((size_t)1 << (height - topHeight)) - 1;
+    topDepth[bottomLevel] = depth;
+    splitLevels(depth, topHeight);
+    splitLevels(bottomLevel, height - topHeight);
+}
+
+/**
+ * @brief Store the elements in van Emde Boas order. The padded complete tree has 2^levels - 1
+ * positions; the in-order ranks past n hold copies of the largest element, which a lower_bound
+ * never returns since the real largest element comes before them.
+ * @param sorted the elements
+ * @param n number of elements
+ */
+void FrozenBST::buildVanEmdeBoas(const T *sorted, size_t n) {
+    if(n == 0){
+        return;
+    }
+    setLevels(n);
+    size_t total = arrayLength();
+    storage.resize(total);
+    T* elements = storage.data();
+
+    //fill positions with a depth-first walk, so that pos[] holds the positions of the current node's ancestors
+    std::vector<size_t> pos(levels);
+    pos[0] = 0;
+    struct Frame { size_t i; int d; };
+    std::vector<Frame> stack;
+    stack.push_back(Frame{1, 0});
+    while(!stack.empty()){
+        Frame frame = stack.back();
+        stack.pop_back();
+        size_t i = frame.i;
+        int d = frame.d;
+        if(d > 0){
+            pos[d] = pos[topDepth[d]] + topSize[d] + (i & topSize[d]) * bottomSize[d];
+        }
+        //the in-order rank of a node at level d with breadth-first index i
+        size_t rank = (2 * (i - ((size_t)1 << d)) + 1) * ((size_t)1 << (levels - 1 - d)) - 1;
+        elements[pos[d]] = sorted[rank < n ? rank : n - 1];
+        if(d + 1 < levels){
+            stack.push_back(Frame{2 * i + 1, d + 1});
+            stack.push_back(Frame{2 * i, d + 1});
+        }
+    }
+}
+
+/**
+ * @brief Find a query element
+ * @param query The query element to find
+ * @return true if query exists in this set, otherwise false
+ */
+bool FrozenBST::find(const T &query) const {
+    const T* found = lower_bound(query);
+    return found != nullptr && !(query < *found);
+}
+
+/**
+ * @brief Find the first element that is not less than key
+ * @param key the key to search for
+ * @return pointer to the element, nullptr if every element is less than key
+ */
+const T *FrozenBST::lower_bound(const T &key) const {
+    return arrayLayout == EYTZINGER ? lowerBoundEytzinger(key) : lowerBoundVanEmdeBoas(key);
+}
+
+/**
+ * @brief Eytzinger lower_bound. The loop goes right while elements are less than key, so the
+ * answer is the last node where it went left: dropping the trailing right turns (1 bits) and
+ * the last left turn (a 0 bit) from k gives its position.
+ */
+const T *FrozenBST::lowerBoundEytzinger(const T &key) const {
+    const T* elements = array();
+    size_t k = 1;
+    while(k <= numElements){
+        //the 16 descendants four levels down share one cache line
+        __builtin_prefetch(elements + LINE * k);
+        k = 2 * k + (elements[k] < key);
+    }
+    k >>= __builtin_ffsll(~k);
+    return k == 0 ? nullptr : elements + k;
+}
+
+/**
+ * @brief van Emde Boas lower_bound. Tracks the breadth-first index i and, for every level,
+ * the position of the node on the search path, from which the next position follows in O(1).
+ */
+const T *FrozenBST::lowerBoundVanEmdeBoas(const T &key) const {
+    const size_t NONE = ~(size_t)0;
+    const T* elements = array();
+    size_t pos[64];
+    size_t i = 1;
+    size_t best = NONE;
+    pos[0] = 0;
+    for(int d = 0; d < levels; ){
+        size_t p = pos[d];
+        bool right = elements[p] < key;
+        //remember the last node where the search went left
+        best = right ? best : p;
+        i = 2 * i + right;
+        if(++d < levels){
+            pos[d] = pos[topDepth[d]] + topSize[d] + (i & topSize[d]) * bottomSize[d];
+        }
+    }
+    return best == NONE ? nullptr : elements + best;
+}
@@ -0,0 +1,148 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file frozen_bst.h
+// @brief This class defines a read-only search array exported from a BST
+//=======================================================
+//
+// A BST search follows one pointer per level to a node that new placed
+// anywhere on the heap, so every level of a large tree is a cache miss that
+// cannot start before the previous one finishes. A key set that stops changing
+// can be frozen into an array laid out for searching instead:
+//
+//  - EYTZINGER stores the tree in breadth-first order, the children of a[k] at
+//    a[2k] and a[2k + 1]. Four levels down from a[k] are the 16 elements from
+//    a[16k], one cache line, so the search prefetches them while it compares at
+//    the levels above, and the branch-free step k = 2k + (a[k] < key) leaves the
+//    processor nothing to mispredict.
+//  - VAN_EMDE_BOAS cuts the tree at half its height and stores the top tree,
+//    then each bottom tree, each of them laid out the same way recursively, so
+//    any path crosses O(log_B n) blocks whatever the block size B. The tree is
+//    padded up to a complete tree of 2^h - 1 elements.
+
+#ifndef ASSIGN_5E_FROZEN_BST_H
+#define ASSIGN_5E_FROZEN_BST_H
+
+#include "BST.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * Sorted, read-only set of elements stored in a search-friendly array layout
+ */
+class FrozenBST
+{
+public:
+    /**
+     * Order of the elements in the array
+     */
+    enum Layout { EYTZINGER, VAN_EMDE_BOAS };
+
+    /**
+     * FrozenBST Constructor, which initializes an empty set
+     */
+    FrozenBST();
+
+    /**
+     * @brief Replace the contents with the given elements
+     * @param sorted elements in ascending order
+     * @param n number of elements
+     * @param layout the array layout to use
+     */
+    void build(const T *sorted, size_t n, Layout layout = EYTZINGER);
+
+    /**
+     * @brief Find a query element
+     * @param query The query element to find
+     * @return true if query exists in this set, otherwise false
+     */
+    bool find(const T &query) const;
+
+    /**
+     * @brief Find the first element that is not less than key
+     * @param key the key to search for
+     * @return pointer to the element, nullptr if every element is less than key
+     */
+    const T *lower_bound(const T &key) const;
+
+    /**
+     * @brief Return the number of elements
+     */
+    size_t size() const { return numElements; }
+
+    /**
+     * @brief Return the layout of the array
+     */
+    Layout layout() const { return arrayLayout; }
+
+    /**
+     * @brief Return the number of bytes held by the array, 0 for a view of a mapped file
+     */
+    size_t memoryUsage() const { return storage.capacity() * sizeof(T); }
+
+    /**
+     * @brief Return the layout array: for EYTZINGER the unused slot 0 and the n elements after it,
+     * for VAN_EMDE_BOAS the padded tree. Searching these arrayLength() elements is all find needs.
+     */
+    const T *array() const { return external ? external : storage.data() + offset; }
+
+    /**
+     * @brief Return the number of elements in array(), 0 for an empty set
+     */
+    size_t arrayLength() const;
+
+    /**
+     * @brief Search an array written from array() elsewhere, such as a mapped file, without copying it.
+     * The array must outlive this FrozenBST and every copy of it.
+     * @param elements the layout array
+     * @param n number of elements in the set
+     * @param layout the layout of the array
+     */
+    void view(const T *elements, size_t n, Layout layout);
+
+private:
+    Layout arrayLayout;
+
+    size_t numElements;
+
+    /**
+     * Backing store. Holds a few more elements than needed so that elements can start on a cache line.
+     */
+    std::vector<T> storage;
+
+    /**
+     * Index in storage where the layout array starts. For EYTZINGER the array is 1-based,
+     * from storage[offset + 1] to storage[offset + n], and storage[offset + 16] starts a cache line
+     * (a moved FrozenBST keeps its buffer; a copy may lose that alignment but still works).
+     * For VAN_EMDE_BOAS it is 0-based and offset is 0.
+     */
+    size_t offset;
+
+    /**
+     * The array being searched when it is not in storage, set by view()
+     */
+    const T *external;
+
+    /**
+     * VAN_EMDE_BOAS: number of levels of the padded complete tree
+     */
+    int levels;
+
+    /**
+     * VAN_EMDE_BOAS navigation tables, one entry per level d > 0. A node at level d is the
+     * root of a bottom tree of bottomSize[d] elements, stored after a top tree of topSize[d]
+     * elements whose root is at level topDepth[d].
+     */
+    std::vector<size_t> topSize;
+    std::vector<size_t> bottomSize;
+    std::vector<int> topDepth;
+
+    void buildEytzinger(T *elements, const T *sorted, size_t &next, size_t k);
+    void buildVanEmdeBoas(const T *sorted, size_t n);
+    void setLevels(size_t n);
+    void splitLevels(int depth, int height);
+    const T *lowerBoundEytzinger(const T &key) const;
+    const T *lowerBoundVanEmdeBoas(const T &key) const;
+};
+
+#endif // ASSIGN_5E_FROZEN_BST_H
@@ -0,0 +1,132 @@
+/**
+ * Implementation of MappedBST class.
+ */
+
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: cpp file mapped_bst.cpp
+// @brief This class implements a frozen BST stored in a file and searched in place through mmap
+//=======================================================
+
+#include "mapped_bst.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char MAGIC[8] = {'B', 'S', 'T', 'F', 'R', 'O', 'Z', 'E'};
+static const uint32_t FORMAT_VERSION = 1;
+
+/**
+ * @brief MappedBST default constructor. An empty set with no file open.
+ */
+MappedBST::MappedBST() : mapping(nullptr), length(0) {
+}
+
+/**
+ * @brief MappedBST destructor. Unmaps the file.
+ */
+MappedBST::~MappedBST() {
+    close();
+}
+
+/**
+ * @brief Unmap the file and become an empty set
+ */
+void MappedBST::close() {
+    if(mapping != nullptr){
+        munmap(mapping, length);
+    }
+    mapping = nullptr;
+    length = 0;
+    tree = FrozenBST();
+}
+
+/**
+ * @brief Write a FrozenBST to a file that open can map: the header, then the layout array as it is in memory.
+ * A file that is already mapped is replaced, not overwritten.
+ * @param tree the set to write
+ * @param path the file to create or replace
+ * @return true if the file was written, false on an I/O error
+ */
+bool MappedBST::save(const FrozenBST &tree, const char *path) {
+    static_assert(sizeof(Header) == 64, "the array must start at byte 64");
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.layout = tree.layout();
+    header.elementSize = sizeof(T);
+    header.numElements = tree.size();
+    header.arrayLength = tree.arrayLength();
+
+    //write a new file and rename it over the old one, so that a mapping of the old file stays valid
+    std::string temporary = std::string(path) + ".tmp";
+    FILE* output = fopen(temporary.c_str(), "wb");
+    if(output == nullptr){
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, output) == 1
+        && fwrite(tree.array(), sizeof(T), header.arrayLength, output) == header.arrayLength;
+    //fclose flushes the buffer, so it can fail too
+    written = fclose(output) == 0 && written;
+    if(!written || rename(temporary.c_str(), path) != 0){
+        unlink(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Map a file written by save. Only the header is read here; the array is paged in by the searches.
+ * @param path the file to map
+ * @return true if the file was mapped, false if it cannot be opened or is not a valid file
+ */
+bool MappedBST::open(const char *path) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if(fd < 0){
+        return false;
+    }
+    struct stat info;
+    if(fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(Header)){
+        ::close(fd);
+        return false;
+    }
+    size_t fileSize = info.st_size;
+    void* data = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    //the mapping keeps its own reference to the file
+    ::close(fd);
+    if(data == MAP_FAILED){
+        return false;
+    }
+
+    const Header* header = static_cast<const Header*>(data);
+    FrozenBST check;
+    bool valid = memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0
+        && header->version == FORMAT_VERSION
+        && header->elementSize == sizeof(T)
+        && (header->layout == FrozenBST::EYTZINGER || header->layout == FrozenBST::VAN_EMDE_BOAS)
+        && header->arrayLength <= (fileSize - sizeof(Header)) / sizeof(T)
+        && header->numElements <= header->arrayLength;
+    if(valid){
+        //the array length must be the one this layout needs for this many elements
+        const T* elements = reinterpret_cast<const T*>(static_cast<const char*>(data) + sizeof(Header));
+        check.view(elements, header->numElements, (FrozenBST::Layout)header->layout);
+        valid = check.arrayLength() == header->arrayLength;
+    }
+    if(!valid){
+        munmap(data, fileSize);
+        return false;
+    }
+    //a search touches one page per level far apart, so reading ahead of a fault only fills memory
+    madvise(data, fileSize, MADV_RANDOM);
+    mapping = data;
+    length = fileSize;
+    tree = check;
+    return true;
+}
@@ -0,0 +1,125 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file mapped_bst.h
+// @brief This class defines a frozen BST stored in a file and searched in place through mmap
+//=======================================================
+//
+// Rebuilding a tree at startup means reading every key and inserting it, and
+// each insert allocates a node and rebalances. A FrozenBST (frozen_bst.h) is
+// already a flat array with no pointers, so it can be written to a file as it
+// is and the file mapped back and searched directly. open only checks the
+// header and maps the file, so it takes the same time for any number of keys;
+// the kernel reads a page of the file the first time a search touches it, and
+// the pages near the root, which every search touches, stay in the page cache.
+//
+// File format, in the byte order of the machine that wrote it:
+//
+//   bytes 0-63   header: magic "BSTFROZE", format version, layout, element
+//                size, number of elements and length of the array
+//   bytes 64-    the FrozenBST layout array, arrayLength() elements
+//
+// The array starts at byte 64 so that an Eytzinger array keeps its 16 element
+// cache lines aligned in the mapping.
+
+#ifndef ASSIGN_5E_MAPPED_BST_H
+#define ASSIGN_5E_MAPPED_BST_H
+
+#include "frozen_bst.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Read-only set of elements searched in place in a memory-mapped file
+ */
+class MappedBST
+{
+public:
+    /**
+     * MappedBST Constructor, which initializes an empty set with no file open
+     */
+    MappedBST();
+
+    /**
+     * MappedBST Destructor. Unmaps the file.
+     */
+    ~MappedBST();
+
+    /**
+     * @brief Write a FrozenBST to a file that open can map
+     * @param tree the set to write
+     * @param path the file to create or replace. A MappedBST that has the old file open keeps searching it.
+     * @return true if the file was written, false on an I/O error
+     */
+    static bool save(const FrozenBST &tree, const char *path);
+
+    /**
+     * @brief Map a file written by save, replacing the current contents. No element is read
+     * until a search needs it.
+     * @param path the file to map
+     * @return true if the file was mapped, false if it cannot be opened or is not a valid file
+     */
+    bool open(const char *path);
+
+    /**
+     * @brief Unmap the file and become an empty set
+     */
+    void close();
+
+    /**
+     * @brief Find a query element
+     * @param query The query element to find
+     * @return true if query exists in this set, otherwise false
+     */
+    bool find(const T &query) const { return tree.find(query); }
+
+    /**
+     * @brief Find the first element that is not less than key
+     * @param key the key to search for
+     * @return pointer into the mapping, nullptr if every element is less than key
+     */
+    const T *lower_bound(const T &key) const { return tree.lower_bound(key); }
+
+    /**
+     * @brief Return the number of elements
+     */
+    size_t size() const { return tree.size(); }
+
+    /**
+     * @brief Return the layout of the array in the file
+     */
+    FrozenBST::Layout layout() const { return tree.layout(); }
+
+    /**
+     * @brief Return the size of the mapping in bytes
+     */
+    size_t mappedBytes() const { return length; }
+
+private:
+    /**
+     * The file header, padded to 64 bytes
+     */
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t layout;
+        uint64_t elementSize;
+        uint64_t numElements;
+        uint64_t arrayLength;
+        char unused[24];
+    };
+
+    /**
+     * A view of the array in the mapping
+     */
+    FrozenBST tree;
+
+    void *mapping;
+
+    size_t length;
+
+    MappedBST(const MappedBST &);
+    MappedBST &operator=(const MappedBST &);
+};
+
+#endif // ASSIGN_5E_MAPPED_BST_H
@@ -0,0 +1,331 @@
+/**
+ * Implementation of PersistentBST class.
+ */
+
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: cpp file persistent_bst.cpp
+// @brief This class implements a persistent AVL tree with lock-free snapshots
+//=======================================================
+
+#include "persistent_bst.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+/**
+ * @brief PersistentBST default constructor. An empty tree in epoch 1 with every reader slot free.
+ */
+PersistentBST::PersistentBST() : root(nullptr), epoch(1), numRetired(0) {
+    for(Slot& slot : slots){
+        slot.epoch.store(0);
+    }
+}
+
+/**
+ * @brief PersistentBST destructor. Frees the current version and every retired node.
+ */
+PersistentBST::~PersistentBST() {
+    clear(root.load());
+    for(Retired& group : retired){
+        for(const Node* node : group.nodes){
+            delete node;
+        }
+    }
+}
+
+/**
+ * @brief Free every node of a subtree
+ * @param node the subtree root
+ */
+void PersistentBST::clear(const Node *node) {
+    while(node != nullptr){
+        clear(node->leftChild);
+        const Node* right = node->rightChild;
+        delete node;
+        node = right;
+    }
+}
+
+/**
+ * @brief Return the number of elements in the current version
+ */
+unsigned int PersistentBST::size() const {
+    const Node* current = root.load();
+    return current ? current->size : 0;
+}
+
+/**
+ * @brief Return the number of replaced nodes still waiting for open snapshots to finish
+ */
+size_t PersistentBST::retiredNodes() const {
+    return numRetired;
+}
+
+/**
+ * @brief Take a snapshot of the current version. The snapshot claims a free reader slot by
+ * writing the current epoch into it before reading the root, so the writer, which advances the
+ * epoch after publishing, either sees the slot or has already published a root this snapshot reads.
+ * @return the snapshot
+ */
+PersistentBST::Snapshot PersistentBST::snapshot() {
+    //start at a slot picked by thread, so threads taking snapshots do not all fight over slot 0
+    size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+    for(size_t i = 0; ; i++){
+        std::atomic<uint64_t>& slot = slots[(start + i) % READER_SLOTS].epoch;
+        uint64_t free = 0;
+        if(slot.load(std::memory_order_relaxed) == 0 && slot.compare_exchange_strong(free, epoch.load())){
+            return Snapshot(root.load(), &slot);
+        }
+        if(i % READER_SLOTS == READER_SLOTS - 1){
+            std::this_thread::yield();
+        }
+    }
+}
+
+/**
+ * @brief Move a snapshot. The moved-from snapshot no longer holds a slot.
+ */
+PersistentBST::Snapshot::Snapshot(Snapshot &&other) : root(other.root), slot(other.slot) {
+    other.slot = nullptr;
+}
+
+/**
+ * @brief Release the snapshot's reader slot, which lets the writer free the nodes of its version
+ */
+PersistentBST::Snapshot::~Snapshot() {
+    if(slot){
+        slot->store(0, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Find a query element in this version
+ * @param query The query element to find
+ * @return true if query exists in this version, otherwise false
+ */
+bool PersistentBST::Snapshot::find(const T &query) const {
+    const Node* node = root;
+    while(node != nullptr){
+        if(node->data == query){
+            return true;
+        }
+        node = (query < node->data) ? node->leftChild : node->rightChild;
+    }
+    return false;
+}
+
+/**
+ * @brief Allocate a node with the given children and compute its height and size
+ * @param data the element of the node
+ * @param left the left subtree
+ * @param right the right subtree
+ * @return the new node
+ */
+const PersistentBST::Node *PersistentBST::makeNode(const T &data, const Node *left, const Node *right) {
+    Node* node = new Node;
+    node->data = data;
+    node->leftChild = left;
+    node->rightChild = right;
+    node->height = 1 + std::max(height(left), height(right));
+    node->size = 1 + (left ? left->size : 0) + (right ? right->size : 0);
+    return node;
+}
+
+/**
+ * @brief Record that node is no longer part of the version being built. It may still be part of
+ * versions that open snapshots are reading, so it is freed later.
+ * @param node the replaced node
+ */
+void PersistentBST::retire(const Node *node) {
+    replaced.push_back(node);
+}
+
+/**
+ * @brief Build a node from data and two AVL subtrees whose heights differ by at most 2.
+ * The nodes a rotation would change are copied and the originals retired.
+ * @param data the element of the new node
+ * @param left the left subtree
+ * @param right the right subtree
+ * @return the root of the balanced subtree
+ */
+const PersistentBST::Node *PersistentBST::balance(const T &data, const Node *left, const Node *right) {
+    if(height(left) > height(right) + 1){
+        retire(left);
+        if(height(left->leftChild) >= height(left->rightChild)){
+            //single right rotation
+            return makeNode(left->data, left->leftChild, makeNode(data, left->rightChild, right));
+        }
+        //left-right double rotation
+        const Node* leftRight = left->rightChild;
+        retire(leftRight);
+        return makeNode(leftRight->data, makeNode(left->data, left->leftChild, leftRight->leftChild),
+                        makeNode(data, leftRight->rightChild, right));
+    }
+    if(height(right) > height(left) + 1){
+        retire(right);
+        if(height(right->rightChild) >= height(right->leftChild)){
+            //single left rotation
+            return makeNode(right->data, makeNode(data, left, right->leftChild), right->rightChild);
+        }
+        //right-left double rotation
+        const Node* rightLeft = right->leftChild;
+        retire(rightLeft);
+        return makeNode(rightLeft->data, makeNode(data, left, rightLeft->leftChild),
+                        makeNode(right->data, rightLeft->rightChild, right->rightChild));
+    }
+    return makeNode(data, left, right);
+}
+
+/**
+ * @brief Return a new version of a subtree with element inserted. Only the path to the new
+ * leaf is copied; the subtrees beside it are shared with the old version.
+ * @param node the subtree root
+ * @param element the element to insert
+ * @return the new subtree root, nullptr if element is already in the subtree
+ */
+const PersistentBST::Node *PersistentBST::insert(const Node *node, const T &element) {
+    if(node == nullptr){
+        return makeNode(element, nullptr, nullptr);
+    }
+    if(element == node->data){
+        return nullptr;
+    }
+    const Node* left = node->leftChild;
+    const Node* right = node->rightChild;
+    if(element < node->data){
+        left = insert(left, element);
+        if(left == nullptr){
+            return nullptr;
+        }
+    }
+    else{
+        right = insert(right, element);
+        if(right == nullptr){
+            return nullptr;
+        }
+    }
+    retire(node);
+    return balance(node->data, left, right);
+}
+
+/**
+ * @brief Return a new version of a non-empty subtree without its smallest node
+ * @param node the subtree root
+ * @param smallest gets the smallest node, which is retired
+ * @return the new subtree root
+ */
+const PersistentBST::Node *PersistentBST::removeSmallest(const Node *node, const Node *&smallest) {
+    retire(node);
+    if(node->leftChild == nullptr){
+        smallest = node;
+        return node->rightChild;
+    }
+    const Node* left = removeSmallest(node->leftChild, smallest);
+    return balance(node->data, left, node->rightChild);
+}
+
+/**
+ * @brief Return a new version of a subtree with element removed
+ * @param node the subtree root
+ * @param element the element to remove
+ * @param removed set to true if element was found
+ * @return the new subtree root, node itself if element was not found
+ */
+const PersistentBST::Node *PersistentBST::remove(const Node *node, const T &element, bool &removed) {
+    if(node == nullptr){
+        return nullptr;
+    }
+    if(element < node->data){
+        const Node* left = remove(node->leftChild, element, removed);
+        if(!removed){
+            return node;
+        }
+        retire(node);
+        return balance(node->data, left, node->rightChild);
+    }
+    if(node->data < element){
+        const Node* right = remove(node->rightChild, element, removed);
+        if(!removed){
+            return node;
+        }
+        retire(node);
+        return balance(node->data, node->leftChild, right);
+    }
+    removed = true;
+    retire(node);
+    if(node->leftChild == nullptr){
+        return node->rightChild;
+    }
+    if(node->rightChild == nullptr){
+        return node->leftChild;
+    }
+    //two children: the successor takes the node's place
+    const Node* successor;
+    const Node* right = removeSmallest(node->rightChild, successor);
+    return balance(successor->data, node->leftChild, right);
+}
+
+/**
+ * @brief Insert a new element by copying its path and publishing a new version
+ * @param element The new element to insert
+ * @return true if the insertion was successful, false if element is already in the tree
+ */
+bool PersistentBST::insert(T element) {
+    std::lock_guard<std::mutex> lock(writer);
+    const Node* newRoot = insert(root.load(), element);
+    if(newRoot == nullptr){
+        //nothing was copied, so nothing was replaced
+        replaced.clear();
+        return false;
+    }
+    publish(newRoot);
+    return true;
+}
+
+/**
+ * @brief Remove an element by copying its path and publishing a new version
+ * @param element The element to remove
+ * @return true if the removal was successful, false if element was not found
+ */
+bool PersistentBST::remove(T element) {
+    std::lock_guard<std::mutex> lock(writer);
+    bool removed = false;
+    const Node* newRoot = remove(root.load(), element, removed);
+    if(!removed){
+        return false;
+    }
+    publish(newRoot);
+    return true;
+}
+
+/**
+ * @brief Publish a new root, advance the epoch and free the retired groups no snapshot can reach.
+ * A snapshot holding epoch e may have read any root published in an epoch up to e, so a group
+ * replaced in epoch r is only reachable by snapshots with e <= r.
+ * @param newRoot the root of the new version
+ */
+void PersistentBST::publish(const Node *newRoot) {
+    root.store(newRoot);
+    uint64_t published = epoch.fetch_add(1);
+    retired.push_back(Retired());
+    retired.back().epoch = published;
+    retired.back().nodes.swap(replaced);
+    numRetired += retired.back().nodes.size();
+
+    uint64_t oldest = published + 1;
+    for(Slot& slot : slots){
+        uint64_t e = slot.epoch.load();
+        if(e != 0){
+            oldest = std::min(oldest, e);
+        }
+    }
+    while(!retired.empty() && retired.front().epoch < oldest){
+        for(const Node* node : retired.front().nodes){
+            delete node;
+        }
+        numRetired -= retired.front().nodes.size();
+        retired.pop_front();
+    }
+}
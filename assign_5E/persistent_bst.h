@@ -0,0 +1,286 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file persistent_bst.h
+// @brief This class defines a persistent AVL tree with lock-free snapshots
+//=======================================================
+//
+// BST changes its nodes in place, so a reader walking it while a writer
+// rebalances can follow a link that is being rewritten, and every reader has
+// to hold the same lock as the writer. PersistentBST never changes a node once
+// it is reachable from a published root. An update copies the O(log n) nodes
+// on its path (and the few it rotates), links the copies to the untouched
+// subtrees, and publishes the new root with one atomic store. A reader takes a
+// Snapshot, which is just the root it saw, and walks it without any lock while
+// later versions are published.
+//
+// Nodes replaced by an update are freed with epochs. A snapshot announces the
+// epoch it started in, in one of a fixed set of reader slots; after each update
+// the writer advances the epoch and frees the nodes retired before the oldest
+// announced epoch, which no snapshot can still reach.
+
+#ifndef ASSIGN_5E_PERSISTENT_BST_H
+#define ASSIGN_5E_PERSISTENT_BST_H
+
+#include "BST.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+/**
+ * AVL tree whose versions can be read by any number of threads while one thread at a time updates it
+ */
+class PersistentBST
+{
+public:
+    /**
+     * A node of the tree. Nodes are shared between versions and never change after they are published.
+     */
+    struct Node
+    {
+        T data;
+        const Node *leftChild;
+        const Node *rightChild;
+        int height;
+        unsigned int size;
+    };
+
+    /**
+     * Number of snapshots that can be open at the same time. Taking one more waits for a slot.
+     */
+    static const int READER_SLOTS = 64;
+
+    /**
+     * A consistent, read-only view of the tree as of the moment it was taken.
+     * It keeps the nodes of its version alive until it is destroyed, so it should be short-lived.
+     */
+    class Snapshot
+    {
+    public:
+        Snapshot(Snapshot &&other);
+        ~Snapshot();
+
+        /**
+         * @brief Find a query element in this version
+         * @param query The query element to find
+         * @return true if query exists in this version, otherwise false
+         */
+        bool find(const T &query) const;
+
+        /**
+         * @brief Return the number of elements in this version
+         */
+        unsigned int size() const { return root ? root->size : 0; }
+
+        /**
+         * @brief Return the height of this version, -1 if it is empty
+         */
+        int height() const { return root ? root->height : -1; }
+
+        /**
+         * @brief Return the root of this version
+         */
+        const Node *getRoot() const { return root; }
+
+        /**
+         * @brief Call callback on every element e with lo <= e <= hi, in ascending order
+         * @param lo lower bound of the range
+         * @param hi upper bound of the range
+         * @param callback function taking a const T&
+         * @return the number of elements passed to callback
+         */
+        template <typename Callback>
+        unsigned int rangeScan(const T &lo, const T &hi, Callback callback) const
+        {
+            return scan(root, lo, hi, callback);
+        }
+
+    private:
+        friend class PersistentBST;
+        Snapshot(const Node *root, std::atomic<uint64_t> *slot) : root(root), slot(slot) {}
+        Snapshot(const Snapshot &);
+        Snapshot &operator=(const Snapshot &);
+
+        template <typename Callback>
+        static unsigned int scan(const Node *node, const T &lo, const T &hi, Callback &callback);
+
+        /**
+         * Root of this version
+         */
+        const Node *root;
+
+        /**
+         * The reader slot holding this snapshot's epoch, nullptr once moved from
+         */
+        std::atomic<uint64_t> *slot;
+    };
+
+    /**
+     * PersistentBST Constructor, which initializes an empty tree
+     */
+    PersistentBST();
+
+    /**
+     * PersistentBST destructor, which frees every node. No snapshot may be open.
+     */
+    ~PersistentBST();
+
+    /**
+     * @brief Take a snapshot of the current version without locking. Safe to call from any thread.
+     * @return the snapshot
+     */
+    Snapshot snapshot();
+
+    /**
+     * @brief Insert a new element by copying its path and publishing a new version.
+     * Updates from several threads are serialized.
+     * @param element The new element to insert
+     * @return true if the insertion was successful, false if element is already in the tree
+     */
+    bool insert(T element);
+
+    /**
+     * @brief Remove an element by copying its path and publishing a new version
+     * @param element The element to remove
+     * @return true if the removal was successful, false if element was not found
+     */
+    bool remove(T element);
+
+    /**
+     * @brief Return the number of elements in the current version
+     */
+    unsigned int size() const;
+
+    /**
+     * @brief Return the number of replaced nodes still waiting for open snapshots to finish
+     */
+    size_t retiredNodes() const;
+
+private:
+    /**
+     * A group of nodes replaced by one update, with the epoch it was published in
+     */
+    struct Retired
+    {
+        uint64_t epoch;
+        std::vector<const Node*> nodes;
+    };
+
+    /**
+     * A reader slot on its own cache line. 0 means free, otherwise the epoch of the snapshot holding it.
+     */
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> epoch;
+    };
+
+    /**
+     * Root of the current version
+     */
+    std::atomic<const Node*> root;
+
+    /**
+     * Current epoch, starting at 1. Advanced after every published update.
+     */
+    std::atomic<uint64_t> epoch;
+
+    Slot slots[READER_SLOTS];
+
+    /**
+     * Serializes updates
+     */
+    std::mutex writer;
+
+    /**
+     * Nodes replaced by the update in progress
+     */
+    std::vector<const Node*> replaced;
+
+    /**
+     * Replaced nodes waiting to be freed, oldest first
+     */
+    std::deque<Retired> retired;
+
+    size_t numRetired;
+
+    /**
+     * @brief Allocate a node with the given children and compute its height and size
+     */
+    static const Node *makeNode(const T &data, const Node *left, const Node *right);
+
+    static int height(const Node *node) { return node ? node->height : -1; }
+
+    /**
+     * @brief Record that node is no longer part of the version being built
+     */
+    void retire(const Node *node);
+
+    /**
+     * @brief Build a node from data and two AVL subtrees whose heights differ by at most 2,
+     * rotating copies of the taller side if needed
+     * @return the root of the balanced subtree
+     */
+    const Node *balance(const T &data, const Node *left, const Node *right);
+
+    /**
+     * @brief Return a new version of a subtree with element inserted
+     * @return the new subtree root, nullptr if element is already in the subtree
+     */
+    const Node *insert(const Node *node, const T &element);
+
+    /**
+     * @brief Return a new version of a subtree with element removed
+     * @param removed set to true if element was found
+     * @return the new subtree root
+     */
+    const Node *remove(const Node *node, const T &element, bool &removed);
+
+    /**
+     * @brief Return a new version of a non-empty subtree without its smallest node
+     * @param smallest gets the smallest node, which is retired
+     */
+    const Node *removeSmallest(const Node *node, const Node *&smallest);
+
+    /**
+     * @brief Publish a new root, advance the epoch and free what no snapshot can reach
+     */
+    void publish(const Node *newRoot);
+
+    /**
+     * @brief Free every node of a subtree
+     */
+    static void clear(const Node *node);
+};
+
+/**
+ * @brief Call callback on the elements of a subtree in [lo, hi], in ascending order
+ */
+template <typename Callback>
+unsigned int PersistentBST::Snapshot::scan(const Node *node, const T &lo, const T &hi, Callback &callback)
+{
+    unsigned int count = 0;
+    while (node != nullptr)
+    {
+        if (node->data < lo)
+        {
+            node = node->rightChild;
+        }
+        else if (hi < node->data)
+        {
+            node = node->leftChild;
+        }
+        else
+        {
+            count += scan(node->leftChild, lo, hi, callback);
+            callback(node->data);
+            count++;
+            node = node->rightChild;
+        }
+    }
+    return count;
+}
+
+#endif // ASSIGN_5E_PERSISTENT_BST_H
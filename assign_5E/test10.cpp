@@ -0,0 +1,147 @@
+/**
+ * This file tests saving frozen arrays to a file and searching them through a mapping
+ *
+ */
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+#include "BST.h"
+#include "frozen_bst.h"
+#include "mapped_bst.h"
+#include "assert.h"
+using namespace std;
+
+static const char* PATH = "test10.tmp";
+
+/**
+ * @brief Compare lower_bound and find of a mapped file with the sorted elements
+ * @param mapped the mapped file
+ * @param sorted the same elements in ascending order
+ */
+void checkMapped(const MappedBST& mapped, const vector<T>& sorted) {
+    assert(mapped.size() == sorted.size());
+    vector<T> keys;
+    for (T element : sorted) {
+        keys.push_back(element - 1);
+        keys.push_back(element);
+        keys.push_back(element + 1);
+    }
+    keys.push_back(-1000000);
+    keys.push_back(1000000);
+    for (T key : keys) {
+        vector<T>::const_iterator expected = lower_bound(sorted.begin(), sorted.end(), key);
+        const T* found = mapped.lower_bound(key);
+        if (expected == sorted.end()) {
+            assert(found == nullptr);
+        } else {
+            assert(found != nullptr && *found == *expected);
+        }
+        assert(mapped.find(key) == binary_search(sorted.begin(), sorted.end(), key));
+    }
+}
+
+/**
+ * @brief Write bytes to the test file
+ */
+void writeFile(const void* data, size_t bytes) {
+    FILE* output = fopen(PATH, "wb");
+    assert(output != nullptr);
+    assert(fwrite(data, 1, bytes, output) == bytes);
+    fclose(output);
+}
+
+/**
+ * @brief Read the test file
+ */
+vector<char> readFile() {
+    vector<char> bytes;
+    FILE* input = fopen(PATH, "rb");
+    assert(input != nullptr);
+    int c;
+    while ((c = fgetc(input)) != EOF) {
+        bytes.push_back((char)c);
+    }
+    fclose(input);
+    return bytes;
+}
+
+int main() {
+    srand(1);
+
+    cout << "Test a round trip of every size up to 200 in both layouts" << endl;
+    for (int n = 0; n <= 200; n++) {
+        vector<T> sorted;
+        T value = 0;
+        for (int i = 0; i < n; i++) {
+            value += 2 + rand() % 3;
+            sorted.push_back(value);
+        }
+        for (FrozenBST::Layout layout : {FrozenBST::EYTZINGER, FrozenBST::VAN_EMDE_BOAS}) {
+            FrozenBST frozen;
+            frozen.build(sorted.data(), sorted.size(), layout);
+            assert(MappedBST::save(frozen, PATH));
+            MappedBST mapped;
+            assert(mapped.open(PATH));
+            assert(mapped.layout() == layout);
+            assert(mapped.mappedBytes() == 64 + frozen.arrayLength() * sizeof(T));
+            checkMapped(mapped, sorted);
+        }
+    }
+
+    cout << "Test saving a frozen AVL tree and reopening it" << endl;
+    BST bst;
+    vector<T> sorted;
+    for (int i = 0; i < 20000; i++) {
+        T num = rand() % 100000;
+        if (!bst.find(num)) {
+            bst.insert(num);
+            sorted.push_back(num);
+        }
+    }
+    sort(sorted.begin(), sorted.end());
+    assert(MappedBST::save(bst.freeze(), PATH));
+    MappedBST mapped;
+    assert(mapped.open(PATH));
+    checkMapped(mapped, sorted);
+    //save replaces the file without touching the one already mapped
+    assert(MappedBST::save(bst.freezeVanEmdeBoas(), PATH));
+    MappedBST other;
+    assert(other.open(PATH));
+    assert(other.layout() == FrozenBST::VAN_EMDE_BOAS);
+    checkMapped(other, sorted);
+    assert(mapped.layout() == FrozenBST::EYTZINGER);
+    checkMapped(mapped, sorted);
+    assert(mapped.open(PATH));
+    checkMapped(mapped, sorted);
+    mapped.close();
+    assert(mapped.size() == 0 && !mapped.find(sorted[0]) && mapped.mappedBytes() == 0);
+
+    cout << "Test files that are not valid" << endl;
+    vector<char> good = readFile();
+    assert(!mapped.open("test10.missing"));
+    writeFile(good.data(), 10);
+    assert(!mapped.open(PATH));
+    //the array is cut short
+    writeFile(good.data(), good.size() - sizeof(T));
+    assert(!mapped.open(PATH));
+    //wrong magic
+    vector<char> bad = good;
+    bad[0] = 'X';
+    writeFile(bad.data(), bad.size());
+    assert(!mapped.open(PATH));
+    //an array length that does not match the element count
+    bad = good;
+    bad[32] ^= 1;
+    writeFile(bad.data(), bad.size());
+    assert(!mapped.open(PATH));
+    assert(mapped.size() == 0 && !mapped.find(sorted[0]));
+    writeFile(good.data(), good.size());
+    assert(mapped.open(PATH));
+    checkMapped(mapped, sorted);
+
+    remove(PATH);
+    cout << "Success" << endl;
+    return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * This file tests the AVL map against std::map, with int and string keys
+ *
+ */
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "avl_map.h"
+#include "avl_check.h"
+#include "assert.h"
+using namespace std;
+
+/**
+ * String comparison that also compares with C strings, so lookups need no std::string
+ */
+struct StringLess
+{
+    typedef void is_transparent;
+
+    static int heterogeneous;
+
+    bool operator()(const string &a, const string &b) const { return a < b; }
+    bool operator()(const char *a, const string &b) const { heterogeneous++; return strcmp(a, b.c_str()) < 0; }
+    bool operator()(const string &a, const char *b) const { heterogeneous++; return strcmp(a.c_str(), b) < 0; }
+};
+
+int StringLess::heterogeneous = 0;
+
+/**
+ * @brief Check a map's structure and compare its contents with a std::map
+ */
+void checkMap(const Map<int, int> &tree, const map<int, int> &expected) {
+    vector<int> keys;
+    checkAVLSubtree(MapView<Map<int, int>::Node>(), tree.getRoot(), nullptr, keys);
+    assert(keys.size() == tree.size() && tree.size() == expected.size());
+    map<int, int>::const_iterator it = expected.begin();
+    for (Map<int, int>::Iterator node = tree.begin(); node != tree.end(); ++node, ++it) {
+        assert(node->key == it->first && node->value == it->second);
+    }
+    assert(it == expected.end());
+}
+
+int main() {
+    srand(1);
+
+    cout << "Test random inserts, assignments and removes against std::map" << endl;
+    Map<int, int> tree;
+    map<int, int> expected;
+    assert(tree.find(1) == nullptr && tree.height() == -1 && tree.begin() == tree.end());
+    for (int i = 0; i < 200000; i++) {
+        int key = rand() % 5000;
+        int value = rand();
+        switch (rand() % 4) {
+        case 0:
+            assert(tree.insert_or_assign(key, value) == (expected.count(key) == 0));
+            expected[key] = value;
+            break;
+        case 1:
+            assert(tree.insert(key, value) == expected.insert(make_pair(key, value)).second);
+            break;
+        case 2:
+            assert(tree.remove(key) == (expected.erase(key) == 1));
+            break;
+        default:
+            tree[key] += value;
+            expected[key] += value;
+        }
+        const int *found = tree.find(key);
+        map<int, int>::iterator it = expected.find(key);
+        assert((found == nullptr) == (it == expected.end()));
+        assert(found == nullptr || *found == it->second);
+        if (i % 10000 == 0) {
+            checkMap(tree, expected);
+        }
+    }
+    checkMap(tree, expected);
+    for (int key = -1; key <= 5001; key += 7) {
+        Map<int, int>::Iterator lower = tree.lower_bound(key);
+        map<int, int>::iterator it = expected.lower_bound(key);
+        assert((lower == tree.end()) == (it == expected.end()));
+        assert(lower == tree.end() || lower->key == it->first);
+    }
+
+    cout << "Test values stay in place while other keys are inserted and removed" << endl;
+    int *value = tree.find(expected.begin()->first);
+    int key = expected.begin()->first;
+    for (int i = 0; i < 1000; i++) {
+        int other = 5000 + rand() % 1000;
+        tree.insert(other, i);
+        if (i % 3 == 0) {
+            tree.remove(other);
+        }
+    }
+    assert(tree.find(key) == value);
+    *value = -1;
+    assert(*tree.find(key) == -1);
+    //removing a node with two children moves its successor node, not the successor's value
+    Map<int, int> small;
+    for (int i = 1; i <= 7; i++) {
+        small.insert(i, i * 10);
+    }
+    int *five = small.find(5);
+    assert(small.getRoot()->key == 4 && small.remove(4));
+    assert(small.find(5) == five && *five == 50 && small.getRoot()->key == 5);
+    small.clear();
+    assert(small.size() == 0 && small.find(5) == nullptr);
+
+    cout << "Test string keys looked up with C strings" << endl;
+    Map<string, string, StringLess> names;
+    assert(names.insert_or_assign("carol", "3"));
+    assert(names.insert_or_assign("alice", "1"));
+    assert(names.insert_or_assign("bob", "2"));
+    assert(!names.insert_or_assign("bob", "two"));
+    StringLess::heterogeneous = 0;
+    const char *bob = "bob";
+    assert(names.find(bob) != nullptr && *names.find(bob) == "two");
+    assert(names.find("dave") == nullptr);
+    assert(names.lower_bound("b")->key == "bob");
+    assert(StringLess::heterogeneous > 0);
+    assert(names.find(string("alice")) != nullptr);
+    assert(names.remove("alice") && !names.remove("alice") && names.size() == 2);
+    names["erin"] = "5";
+    assert(*names.find("erin") == "5");
+
+    cout << "Success" << endl;
+    return 0;
+}
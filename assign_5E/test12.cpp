@@ -0,0 +1,130 @@
+/**
+ * This file tests find and insert starting from a finger on sorted, nearly sorted and random key streams
+ *
+ */
+#include <algorithm>
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+#include "BST.h"
+#include "avl_check.h"
+#include "assert.h"
+using namespace std;
+
+/**
+ * @brief Insert a stream of keys with a finger, check the tree, then look every key and its neighbours up with a finger
+ * @param keys the stream
+ */
+void checkStream(const vector<T>& keys) {
+    BST bst;
+    BST::Node* finger = nullptr;
+    for (T key : keys) {
+        assert(bst.insert(key, finger));
+        assert(finger != nullptr && finger->data == key);
+    }
+    vector<T> expected = keys;
+    sort(expected.begin(), expected.end());
+    vector<T> elements;
+    checkAVLSubtree(LinkedView<BST::Node>(), bst.getRoot(), nullptr, elements);
+    assert(elements == expected && bst.size() == expected.size());
+
+    finger = nullptr;
+    for (T key : keys) {
+        for (T query = key - 1; query <= key + 1; query++) {
+            bool found = bst.find(query, finger);
+            assert(found == binary_search(expected.begin(), expected.end(), query));
+            assert(found == bst.find(query));
+            assert(finger != nullptr);
+            if (found) {
+                assert(finger->data == query);
+            }
+        }
+    }
+}
+
+int main() {
+    srand(1);
+    const int n = 20000;
+
+    cout << "Test a sorted stream" << endl;
+    vector<T> keys;
+    for (int i = 0; i < n; i++) {
+        keys.push_back(3 * i);
+    }
+    checkStream(keys);
+
+    cout << "Test a reverse sorted stream" << endl;
+    reverse(keys.begin(), keys.end());
+    checkStream(keys);
+
+    cout << "Test a nearly sorted stream" << endl;
+    reverse(keys.begin(), keys.end());
+    for (int i = 0; i + 8 < n; i++) {
+        swap(keys[i], keys[i + rand() % 8]);
+    }
+    checkStream(keys);
+
+    cout << "Test a random stream with repeated keys" << endl;
+    keys.clear();
+    for (int i = 0; i < n; i++) {
+        keys.push_back(3 * (rand() % (n / 2)));
+    }
+    checkStream(keys);
+
+    cout << "Test fingers anywhere in the tree" << endl;
+    BST bst;
+    vector<T> expected;
+    for (int i = 0; i < 2000; i++) {
+        expected.push_back(2 * i);
+    }
+    bst.buildFromSorted(expected.data(), expected.size());
+    for (int i = 0; i < 20000; i++) {
+        BST::Node* finger = bst.select(rand() % bst.size());
+        T query = rand() % 4200 - 100;
+        bool found = bst.find(query, finger);
+        assert(found == binary_search(expected.begin(), expected.end(), query));
+        assert(!found || finger->data == query);
+        if (i % 10 == 0) {
+            finger = bst.select(rand() % bst.size());
+            bst.insert(query, finger);
+            expected.insert(upper_bound(expected.begin(), expected.end(), query), query);
+        }
+    }
+    vector<T> elements;
+    checkAVLSubtree(LinkedView<BST::Node>(), bst.getRoot(), nullptr, elements);
+    assert(elements == expected);
+
+    cout << "Test a finger on the successor of a removed node with two children" << endl;
+    BST removing;
+    vector<T> kept;
+    for (int i = 0; i < 1000; i++) {
+        removing.insert(2 * i);
+        kept.push_back(2 * i);
+    }
+    for (int round = 0; round < 300; round++) {
+        BST::Node* node = removing.select(rand() % removing.size());
+        if (node->leftChild == nullptr || node->rightChild == nullptr) {
+            continue;
+        }
+        T removed = node->data;
+        vector<T>::iterator it = lower_bound(kept.begin(), kept.end(), removed);
+        T successor = *(it + 1);
+        BST::Node* finger = nullptr;
+        assert(removing.find(successor, finger) && finger->data == successor);
+        assert(removing.remove(removed));
+        kept.erase(it);
+        //the finger still points at the successor's node
+        assert(finger->data == successor);
+        T query = kept[rand() % kept.size()];
+        assert(removing.find(query, finger) && finger->data == query);
+        finger = removing.select(0);
+        assert(removing.insert(removed + 1, finger) && finger->data == removed + 1);
+        kept.insert(upper_bound(kept.begin(), kept.end(), removed + 1), removed + 1);
+    }
+    elements.clear();
+    checkAVLSubtree(LinkedView<BST::Node>(), removing.getRoot(), nullptr, elements);
+    assert(elements == kept);
+
+    cout << "Success" << endl;
+    return 0;
+}
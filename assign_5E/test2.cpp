@@ -0,0 +1,79 @@
+/**
+ * This file tests the arena-backed AVL tree against std::set
+ *
+ */
+#include <iostream>
+#include <set>
+#include <stdlib.h>
+#include <vector>
+#include "arena_bst.h"
+#include "avl_check.h"
+#include "assert.h"
+using namespace std;
+
+/**
+ * @brief Check the whole tree holds exactly the elements of expected
+ */
+void checkTree(const ArenaBST& tree, const set<T>& expected) {
+    vector<T> elements;
+    int height = checkAVLSubtree(ArenaView<ArenaBST>{tree}, tree.getRoot(), ArenaBST::NIL, elements);
+    assert(height == tree.height());
+    assert(tree.size() == expected.size());
+    assert(elements == vector<T>(expected.begin(), expected.end()));
+}
+
+int main() {
+    srand(1);
+
+    cout << "Test node size" << endl;
+    assert(sizeof(ArenaBST::Node) + 1 < sizeof(BST::Node) / 2);
+
+    cout << "Test the printed tree" << endl;
+    ArenaBST tree;
+    for (int num : {5, 3, 8, 1, 4, 9, 2}) {
+        assert(tree.insert(num));
+    }
+    assert(!tree.insert(4));
+    cout << "tree: ";
+    tree.printInorder(tree.getRoot());
+    cout << endl << "balance factor: ";
+    tree.printBalanceFactors(tree.getRoot());
+    cout << endl;
+
+    cout << "Test random inserts and removes against std::set" << endl;
+    tree.clear();
+    assert(tree.size() == 0 && tree.getRoot() == ArenaBST::NIL && tree.memoryUsage() == 0);
+    set<T> expected;
+    for (int round = 0; round < 20000; round++) {
+        T num = rand() % 2000;
+        if (rand() % 3 == 0) {
+            assert(tree.remove(num) == (expected.erase(num) == 1));
+        } else {
+            assert(tree.insert(num) == expected.insert(num).second);
+        }
+        assert(tree.find(num) == (expected.count(num) == 1));
+        if (round % 1000 == 0) {
+            checkTree(tree, expected);
+        }
+    }
+    checkTree(tree, expected);
+
+    cout << "Test removed nodes are reused" << endl;
+    size_t memory = tree.memoryUsage();
+    for (T num : expected) {
+        assert(tree.remove(num));
+    }
+    assert(tree.size() == 0 && tree.height() == -1);
+    for (int num = 0; num < 1000; num++) {
+        tree.insert(num);
+    }
+    assert(tree.memoryUsage() == memory);
+    expected.clear();
+    for (int num = 0; num < 1000; num++) {
+        expected.insert(num);
+    }
+    checkTree(tree, expected);
+
+    cout << "Success" << endl;
+    return 0;
+}
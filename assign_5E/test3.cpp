@@ -0,0 +1,90 @@
+/**
+ * This file tests building a balanced AVL tree from sorted and unsorted input
+ *
+ */
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <stdlib.h>
+#include <vector>
+#include "BST.h"
+#include "avl_check.h"
+#include "assert.h"
+using namespace std;
+
+/**
+ * @brief Check the whole tree is a valid AVL tree holding exactly the expected elements
+ */
+void checkTree(BST& bst, const vector<T>& expected) {
+    vector<T> elements;
+    int height = checkAVLSubtree(LinkedView<BST::Node>(), bst.getRoot(), nullptr, elements);
+    assert(height == bst.height());
+    assert(bst.size() == expected.size());
+    assert(elements == expected);
+}
+
+int main() {
+    srand(1);
+
+    cout << "Test building from sorted input" << endl;
+    BST bst;
+    for (size_t n : {0, 1, 2, 3, 7, 8, 100, 1000}) {
+        vector<T> sorted(n);
+        for (size_t i = 0; i < n; i++) {
+            sorted[i] = 3 * i - 500;
+        }
+        bst.buildFromSorted(sorted.data(), n);
+        checkTree(bst, sorted);
+    }
+
+    cout << "Test repeated elements are stored once" << endl;
+    T repeated[] = {1, 1, 2, 3, 3, 3, 9};
+    bst.buildFromSorted(repeated, 7);
+    checkTree(bst, {1, 2, 3, 9});
+
+    cout << "Test building from unsorted input" << endl;
+    vector<T> nums;
+    for (int i = 0; i < 5000; i++) {
+        nums.push_back(rand() % 2000);
+    }
+    bst.buildFromUnsorted(nums.data(), nums.size());
+    sort(nums.begin(), nums.end());
+    nums.erase(unique(nums.begin(), nums.end()), nums.end());
+    checkTree(bst, nums);
+
+    cout << "Test the built tree stays balanced through inserts and removes" << endl;
+    for (int i = 0; i < 300; i++) {
+        bst.insert(2000 + i);
+        nums.push_back(2000 + i);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        if (bst.remove(i)) {
+            nums.erase(lower_bound(nums.begin(), nums.end(), i));
+        }
+    }
+    checkTree(bst, nums);
+
+    cout << "Test random inserts and removes keep the stored heights exact" << endl;
+    bst.clear();
+    bst.resetStats();
+    set<T> expected;
+    for (int round = 0; round < 20000; round++) {
+        T num = rand() % 3000;
+        if (rand() % 3 == 0) {
+            if (bst.remove(num)) {
+                expected.erase(num);
+            }
+        } else if (expected.insert(num).second) {
+            bst.insert(num);
+        }
+        if (round % 500 == 0) {
+            checkTree(bst, vector<T>(expected.begin(), expected.end()));
+        }
+    }
+    checkTree(bst, vector<T>(expected.begin(), expected.end()));
+    // retracing stops early, so on average only a couple of ancestors are visited per change
+    assert(bst.stats().visits < 20000ul * 4 && bst.stats().rotations > 0);
+
+    cout << "Success" << endl;
+    return 0;
+}
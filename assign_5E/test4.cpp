@@ -0,0 +1,91 @@
+/**
+ * This file tests the order-statistic operations of the AVL tree against a sorted vector
+ *
+ */
+#include <algorithm>
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+#include "BST.h"
+#include "assert.h"
+using namespace std;
+
+/**
+ * @brief Check every subtree size matches the number of nodes below it
+ * @return the number of nodes in the subtree rooted at node
+ */
+unsigned int checkSizes(BST::Node* node) {
+    if (node == nullptr) {
+        return 0;
+    }
+    unsigned int size = 1 + checkSizes(node->leftChild) + checkSizes(node->rightChild);
+    assert(node->size == size);
+    return size;
+}
+
+/**
+ * @brief Compare rank, select and countRange with the sorted vector
+ * @param bst the tree
+ * @param oracle the elements of the tree in ascending order
+ */
+void checkQueries(BST& bst, const vector<T>& oracle) {
+    checkSizes(bst.getRoot());
+    for (unsigned int k = 0; k < oracle.size(); k++) {
+        assert(bst.select(k) != nullptr && bst.select(k)->data == oracle[k]);
+    }
+    assert(bst.select(oracle.size()) == nullptr);
+    for (int i = 0; i < 200; i++) {
+        T key = rand() % 2200 - 100;
+        unsigned int less = lower_bound(oracle.begin(), oracle.end(), key) - oracle.begin();
+        assert(bst.rank(key) == less);
+        T hi = key + rand() % 300;
+        unsigned int inRange = upper_bound(oracle.begin(), oracle.end(), hi) - oracle.begin() - less;
+        assert(bst.countRange(key, hi) == inRange);
+        assert(bst.countRange(hi + 1, key) == 0);
+    }
+}
+
+int main() {
+    srand(1);
+
+    cout << "Test an empty tree" << endl;
+    BST bst;
+    checkQueries(bst, {});
+
+    cout << "Test a small tree" << endl;
+    for (int num : {50, 20, 80, 10, 30, 70, 90}) {
+        bst.insert(num);
+    }
+    assert(bst.rank(10) == 0 && bst.rank(30) == 2 && bst.rank(31) == 3 && bst.rank(100) == 7);
+    assert(bst.select(3)->data == 50);
+    assert(bst.countRange(20, 70) == 4 && bst.countRange(21, 29) == 0 && bst.countRange(90, 90) == 1);
+
+    cout << "Test random inserts and removes" << endl;
+    bst.clear();
+    vector<T> oracle;
+    for (int round = 0; round < 4000; round++) {
+        T num = rand() % 2000;
+        vector<T>::iterator at = lower_bound(oracle.begin(), oracle.end(), num);
+        bool present = at != oracle.end() && *at == num;
+        if (rand() % 3 == 0) {
+            assert(bst.remove(num) == present);
+            if (present) {
+                oracle.erase(at);
+            }
+        } else if (!present) {
+            bst.insert(num);
+            oracle.insert(at, num);
+        }
+        if (round % 400 == 0) {
+            checkQueries(bst, oracle);
+        }
+    }
+    checkQueries(bst, oracle);
+
+    cout << "Test a bulk-loaded tree" << endl;
+    bst.buildFromSorted(oracle.data(), oracle.size());
+    checkQueries(bst, oracle);
+
+    cout << "Success" << endl;
+    return 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * This file tests the in-order iterators and range scans of the AVL tree
+ *
+ */
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <stdlib.h>
+#include <vector>
+#include "BST.h"
+#include "assert.h"
+
+using namespace std;
+
+int main() {
+    srand(1);
+
+    cout << "Test an empty BST" << endl;
+    BST bst;
+    assert(bst.begin() == bst.end());
+    assert(bst.lower_bound(5) == bst.end());
+    assert(bst.rangeScan(0, 100, [](const T&) { assert(false); }) == 0);
+
+    cout << "Test iterating in ascending order" << endl;
+    set<T> expected;
+    while (expected.size() < 500) {
+        T num = rand() % 4000 - 2000;
+        if (expected.insert(num).second) {
+            bst.insert(num);
+        }
+    }
+    vector<T> elements;
+    for (T element : bst) {
+        elements.push_back(element);
+    }
+    assert(elements == vector<T>(expected.begin(), expected.end()));
+    assert(equal(bst.begin(), bst.end(), expected.begin()));
+
+    cout << "Test lower_bound and rangeScan" << endl;
+    for (int i = 0; i < 500; i++) {
+        T lo = rand() % 4400 - 2200;
+        T hi = lo + rand() % 400;
+        set<T>::iterator found = expected.lower_bound(lo);
+        BST::Iterator it = bst.lower_bound(lo);
+        assert(found == expected.end() ? it == bst.end() : *it == *found);
+        vector<T> scanned;
+        unsigned int count = bst.rangeScan(lo, hi, [&](const T& element) { scanned.push_back(element); });
+        assert(count == scanned.size());
+        assert(scanned == vector<T>(found, expected.upper_bound(hi)));
+    }
+
+    cout << "Test a tree built from sorted inserts" << endl;
+    BST chain;
+    for (int num = 0; num < 3000; num++) {
+        chain.insert(num);
+    }
+    int next = 0;
+    for (BST::Iterator it = chain.begin(); it != chain.end(); it++) {
+        assert(*it == next++);
+    }
+    assert(next == 3000);
+    assert(chain.rangeScan(1000, 1999, [](const T&) {}) == 1000);
+    assert(*chain.lower_bound(1500) == 1500 && chain.lower_bound(3000) == chain.end());
+    chain.clear();
+    assert(chain.size() == 0 && chain.begin() == chain.end());
+
+    cout << "Success" << endl;
+    return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ * This file tests split, join, the parallel set operations and the batch updates of the AVL tree against the standard set algorithms
+ *
+ */
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <stdlib.h>
+#include <vector>
+#include "BST.h"
+#include "avl_check.h"
+#include "assert.h"
+using namespace std;
+
+/**
+ * @brief Check the whole tree holds exactly the elements of expected, in order
+ */
+void checkTree(BST& bst, const vector<T>& expected) {
+    vector<T> elements;
+    checkAVLSubtree(LinkedView<BST::Node>(), bst.getRoot(), nullptr, elements);
+    assert(bst.size() == expected.size());
+    assert(elements == expected);
+}
+
+/**
+ * @brief Return count distinct random elements below limit, sorted
+ */
+vector<T> randomSet(int count, int limit) {
+    vector<T> elements;
+    for (int i = 0; i < count; i++) {
+        elements.push_back(rand() % limit);
+    }
+    sort(elements.begin(), elements.end());
+    elements.erase(unique(elements.begin(), elements.end()), elements.end());
+    return elements;
+}
+
+/**
+ * @brief Run the three set operations on two sets and compare with std::set_union and friends
+ * @param a the first set, sorted
+ * @param b the second set, sorted
+ * @param threads number of tasks passed to the set operations
+ */
+void checkSetOperations(const vector<T>& a, const vector<T>& b, unsigned int threads) {
+    BST first, second;
+    vector<T> expected;
+
+    first.buildFromSorted(a.data(), a.size());
+    second.buildFromSorted(b.data(), b.size());
+    first.unionWith(second, threads);
+    set_union(a.begin(), a.end(), b.begin(), b.end(), back_inserter(expected));
+    checkTree(first, expected);
+    checkTree(second, {});
+
+    expected.clear();
+    first.buildFromSorted(a.data(), a.size());
+    second.buildFromSorted(b.data(), b.size());
+    first.intersectWith(second, threads);
+    set_intersection(a.begin(), a.end(), b.begin(), b.end(), back_inserter(expected));
+    checkTree(first, expected);
+    checkTree(second, {});
+
+    expected.clear();
+    first.buildFromSorted(a.data(), a.size());
+    second.buildFromSorted(b.data(), b.size());
+    first.differenceWith(second, threads);
+    set_difference(a.begin(), a.end(), b.begin(), b.end(), back_inserter(expected));
+    checkTree(first, expected);
+    checkTree(second, {});
+}
+
+int main() {
+    srand(1);
+
+    cout << "Test split and join" << endl;
+    BST bst, less, greater;
+    vector<T> elements = randomSet(5000, 20000);
+    for (int i = 0; i < 50; i++) {
+        bst.buildFromSorted(elements.data(), elements.size());
+        T key = rand() % 22000 - 1000;
+        vector<T>::iterator at = lower_bound(elements.begin(), elements.end(), key);
+        bool present = at != elements.end() && *at == key;
+        assert(bst.split(key, less, greater) == present);
+        checkTree(bst, {});
+        checkTree(less, vector<T>(elements.begin(), at));
+        checkTree(greater, vector<T>(present ? at + 1 : at, elements.end()));
+
+        //join the halves back together, with the key in between when it was present
+        if (present) {
+            BST middle;
+            middle.insert(key);
+            less.join(middle);
+        }
+        less.join(greater);
+        checkTree(less, elements);
+        checkTree(greater, {});
+    }
+
+    cout << "Test join of very different heights" << endl;
+    vector<T> small = {-3, -2, -1};
+    less.buildFromSorted(small.data(), small.size());
+    greater.buildFromSorted(elements.data(), elements.size());
+    less.join(greater);
+    small.insert(small.end(), elements.begin(), elements.end());
+    checkTree(less, small);
+    greater.buildFromSorted(small.data(), 2);
+    less.clear();
+    vector<T> big(small.begin() + 2, small.end());
+    less.buildFromSorted(big.data(), big.size());
+    greater.join(less);
+    checkTree(greater, small);
+
+    cout << "Test set operations with empty sets" << endl;
+    checkSetOperations({}, {}, 1);
+    checkSetOperations(elements, {}, 1);
+    checkSetOperations({}, elements, 1);
+    checkSetOperations(elements, elements, 4);
+
+    cout << "Test set operations on random sets" << endl;
+    for (unsigned int threads : {1u, 4u}) {
+        checkSetOperations(randomSet(3000, 5000), randomSet(3000, 5000), threads);
+        checkSetOperations(randomSet(30000, 100000), randomSet(20000, 100000), threads);
+        checkSetOperations(randomSet(40000, 100000), randomSet(50, 100000), threads);
+        checkSetOperations(randomSet(50, 100000), randomSet(40000, 100000), threads);
+    }
+
+    cout << "Test batch inserts and removes" << endl;
+    bst.clear();
+    set<T> expected;
+    for (int round = 0; round < 40; round++) {
+        vector<T> batch;
+        int count = round % 10 == 0 ? 2000 : rand() % 200;
+        for (int i = 0; i < count; i++) {
+            batch.push_back(rand() % 5000);
+        }
+        size_t changed = 0;
+        if (round % 3 == 2) {
+            for (T num : batch) {
+                changed += expected.erase(num);
+            }
+            assert(bst.removeBatch(batch.data(), batch.size()) == changed);
+        } else {
+            for (T num : batch) {
+                changed += expected.insert(num).second;
+            }
+            assert(bst.insertBatch(batch.data(), batch.size()) == changed);
+        }
+        checkTree(bst, vector<T>(expected.begin(), expected.end()));
+    }
+    assert(bst.insertBatch(nullptr, 0) == 0 && bst.removeBatch(nullptr, 0) == 0);
+
+    cout << "Test batch removes from trees holding duplicates" << endl;
+    for (int count : {10, 400}) {
+        bst.clear();
+        multiset<T> copies;
+        for (int i = 0; i < 1000; i++) {
+            T num = rand() % 200;
+            bst.insert(num);
+            copies.insert(num);
+        }
+        for (int round = 0; round < 5; round++) {
+            vector<T> batch;
+            for (int i = 0; i < count; i++) {
+                batch.push_back(rand() % 200);
+            }
+            size_t changed = 0;
+            for (T num : set<T>(batch.begin(), batch.end())) {
+                auto it = copies.find(num);
+                if (it != copies.end()) {
+                    copies.erase(it);
+                    changed++;
+                }
+            }
+            assert(bst.removeBatch(batch.data(), batch.size()) == changed);
+            checkTree(bst, vector<T>(copies.begin(), copies.end()));
+        }
+    }
+
+    cout << "Success" << endl;
+    return 0;
+}
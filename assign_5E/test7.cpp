@@ -0,0 +1,114 @@
+/**
+ * This file tests the persistent AVL tree: its versions against std::set, that snapshots
+ * keep their version while the tree changes, and concurrent readers during updates
+ *
+ */
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <set>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+#include "persistent_bst.h"
+#include "avl_check.h"
+#include "assert.h"
+using namespace std;
+
+/**
+ * @brief Check a snapshot holds exactly the elements of expected
+ */
+void checkSnapshot(const PersistentBST::Snapshot& snapshot, const set<T>& expected) {
+    vector<T> elements;
+    checkAVLSubtree(SharedView<PersistentBST::Node>(), snapshot.getRoot(), nullptr, elements);
+    assert(snapshot.size() == expected.size());
+    assert(elements == vector<T>(expected.begin(), expected.end()));
+}
+
+int main() {
+    srand(1);
+
+    cout << "Test random inserts and removes against std::set" << endl;
+    PersistentBST tree;
+    set<T> expected;
+    for (int round = 0; round < 20000; round++) {
+        T num = rand() % 2000;
+        if (rand() % 3 == 0) {
+            assert(tree.remove(num) == (expected.erase(num) == 1));
+        } else {
+            assert(tree.insert(num) == expected.insert(num).second);
+        }
+        assert(tree.snapshot().find(num) == (expected.count(num) == 1));
+        if (round % 1000 == 0) {
+            checkSnapshot(tree.snapshot(), expected);
+        }
+    }
+    checkSnapshot(tree.snapshot(), expected);
+    assert(tree.size() == expected.size());
+
+    cout << "Test snapshots keep their version" << endl;
+    vector<PersistentBST::Snapshot> snapshots;
+    vector<set<T> > versions;
+    for (int round = 0; round < 10; round++) {
+        snapshots.push_back(tree.snapshot());
+        versions.push_back(expected);
+        for (int i = 0; i < 300; i++) {
+            T num = rand() % 2000;
+            if (rand() % 2 == 0) {
+                tree.remove(num);
+                expected.erase(num);
+            } else {
+                tree.insert(num);
+                expected.insert(num);
+            }
+        }
+    }
+    assert(tree.retiredNodes() > 0);
+    for (size_t i = 0; i < snapshots.size(); i++) {
+        checkSnapshot(snapshots[i], versions[i]);
+    }
+    T lo = 500, hi = 900;
+    vector<T> inRange;
+    assert(snapshots[3].rangeScan(lo, hi, [&inRange](const T& element) { inRange.push_back(element); })
+           == inRange.size());
+    assert(inRange == vector<T>(versions[3].lower_bound(lo), versions[3].upper_bound(hi)));
+
+    cout << "Test retired nodes are freed once snapshots close" << endl;
+    snapshots.clear();
+    tree.insert(-1);
+    assert(tree.retiredNodes() == 0);
+
+    cout << "Test readers while a writer updates" << endl;
+    //every snapshot a reader takes must be a whole, valid version: sorted, balanced and
+    //with the right sizes, even though the writer keeps replacing and freeing nodes
+    PersistentBST shared;
+    const int n = 20000;
+    atomic<bool> done(false);
+    vector<thread> readers;
+    for (int r = 0; r < 4; r++) {
+        readers.push_back(thread([&shared, &done]() {
+            while (!done.load()) {
+                PersistentBST::Snapshot snapshot = shared.snapshot();
+                vector<T> elements;
+                checkAVLSubtree(SharedView<PersistentBST::Node>(), snapshot.getRoot(), nullptr, elements);
+                assert(elements.size() == snapshot.size());
+                assert(is_sorted(elements.begin(), elements.end()));
+                assert(snapshot.size() == 0 || snapshot.find(elements.back()));
+            }
+        }));
+    }
+    for (int num = 0; num < n; num++) {
+        shared.insert(num);
+    }
+    for (int num = 0; num < n; num += 2) {
+        shared.remove(num);
+    }
+    done.store(true);
+    for (thread& reader : readers) {
+        reader.join();
+    }
+    assert(shared.size() == n / 2);
+
+    cout << "Success" << endl;
+    return 0;
+}
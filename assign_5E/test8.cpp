@@ -0,0 +1,85 @@
+/**
+ * This file tests the frozen Eytzinger and van Emde Boas arrays against std::lower_bound on a sorted vector
+ *
+ */
+#include <algorithm>
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+#include "BST.h"
+#include "frozen_bst.h"
+#include "assert.h"
+using namespace std;
+
+/**
+ * @brief Compare lower_bound and find of a frozen array with the sorted elements
+ * @param frozen the frozen array
+ * @param sorted the same elements in ascending order
+ */
+void checkFrozen(const FrozenBST& frozen, const vector<T>& sorted) {
+    assert(frozen.size() == sorted.size());
+    vector<T> keys;
+    for (T element : sorted) {
+        keys.push_back(element - 1);
+        keys.push_back(element);
+        keys.push_back(element + 1);
+    }
+    keys.push_back(-1000000);
+    keys.push_back(1000000);
+    for (T key : keys) {
+        vector<T>::const_iterator expected = lower_bound(sorted.begin(), sorted.end(), key);
+        const T* found = frozen.lower_bound(key);
+        if (expected == sorted.end()) {
+            assert(found == nullptr);
+        } else {
+            assert(found != nullptr && *found == *expected);
+        }
+        assert(frozen.find(key) == binary_search(sorted.begin(), sorted.end(), key));
+    }
+}
+
+int main() {
+    srand(1);
+
+    cout << "Test every size up to 300 in both layouts" << endl;
+    for (int n = 0; n <= 300; n++) {
+        vector<T> sorted;
+        T value = 0;
+        for (int i = 0; i < n; i++) {
+            value += 2 + rand() % 3;
+            sorted.push_back(value);
+        }
+        for (FrozenBST::Layout layout : {FrozenBST::EYTZINGER, FrozenBST::VAN_EMDE_BOAS}) {
+            FrozenBST frozen;
+            frozen.build(sorted.data(), sorted.size(), layout);
+            assert(frozen.layout() == layout);
+            checkFrozen(frozen, sorted);
+        }
+    }
+
+    cout << "Test freezing an AVL tree" << endl;
+    BST bst;
+    vector<T> sorted;
+    for (int i = 0; i < 20000; i++) {
+        T num = rand() % 100000;
+        if (!bst.find(num)) {
+            bst.insert(num);
+            sorted.push_back(num);
+        }
+    }
+    sort(sorted.begin(), sorted.end());
+    FrozenBST frozen = bst.freeze();
+    assert(frozen.layout() == FrozenBST::EYTZINGER);
+    checkFrozen(frozen, sorted);
+    FrozenBST vanEmdeBoas = bst.freezeVanEmdeBoas();
+    assert(vanEmdeBoas.layout() == FrozenBST::VAN_EMDE_BOAS);
+    checkFrozen(vanEmdeBoas, sorted);
+    assert(bst.size() == sorted.size());
+
+    cout << "Test a frozen copy stays correct" << endl;
+    FrozenBST copy = frozen;
+    checkFrozen(copy, sorted);
+
+    cout << "Success" << endl;
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * This file tests the B+-tree with one, two and four cache lines per node against std::set
+ *
+ */
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <set>
+#include <stdlib.h>
+#include <vector>
+#include "bplus_tree.h"
+#include "assert.h"
+using namespace std;
+
+/**
+ * @brief Check a subtree: keys sorted and within (lo, hi], every node but the root at least half full,
+ * and the leaves in order. Collects the leaves from left to right.
+ */
+template <int LINES>
+void checkSubtree(const typename BPlusTree<LINES>::Node* node, int depth, int levels, bool isRoot,
+                  vector<const typename BPlusTree<LINES>::Leaf*>& leaves) {
+    typedef BPlusTree<LINES> Tree;
+    assert(node->count <= Tree::KEYS);
+    assert(isRoot || node->count >= Tree::MIN_KEYS);
+    for (int i = 1; i < node->count; i++) {
+        assert(node->keys[i - 1] < node->keys[i]);
+    }
+    if (depth == levels) {
+        leaves.push_back(static_cast<const typename Tree::Leaf*>(node));
+        return;
+    }
+    const typename Tree::Inner* inner = static_cast<const typename Tree::Inner*>(node);
+    assert(inner->count >= 1);
+    for (int i = 0; i <= inner->count; i++) {
+        size_t first = leaves.size();
+        checkSubtree<LINES>(inner->children[i], depth + 1, levels, false, leaves);
+        //every element under children[i] lies between the separators around it
+        for (size_t l = first; l < leaves.size(); l++) {
+            for (int k = 0; k < leaves[l]->count; k++) {
+                assert(i == 0 || !(leaves[l]->keys[k] < inner->keys[i - 1]));
+                assert(i == inner->count || leaves[l]->keys[k] < inner->keys[i]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Check the whole tree holds exactly the elements of expected
+ */
+template <int LINES>
+void checkTree(const BPlusTree<LINES>& tree, const set<T>& expected) {
+    assert(tree.size() == expected.size());
+    if (tree.getRoot() == nullptr) {
+        assert(expected.empty() && tree.height() == 0 && tree.begin() == tree.end());
+        return;
+    }
+    vector<const typename BPlusTree<LINES>::Leaf*> leaves;
+    checkSubtree<LINES>(tree.getRoot(), 1, tree.height(), true, leaves);
+    for (size_t l = 0; l < leaves.size(); l++) {
+        assert(leaves[l]->next == (l + 1 < leaves.size() ? leaves[l + 1] : nullptr));
+    }
+    assert(vector<T>(tree.begin(), tree.end()) == vector<T>(expected.begin(), expected.end()));
+}
+
+/**
+ * @brief Run random inserts, removes and queries against std::set
+ */
+template <int LINES>
+void testTree() {
+    cout << "Test " << LINES << " cache line" << (LINES == 1 ? "" : "s") << " per node, "
+         << BPlusTree<LINES>::KEYS << " keys" << endl;
+    BPlusTree<LINES> tree;
+    set<T> expected;
+    checkTree(tree, expected);
+    for (int round = 0; round < 60000; round++) {
+        //grow to a few thousand elements, then shrink back to nothing
+        T num = rand() % 6000;
+        bool grow = round < 30000 ? rand() % 4 != 0 : rand() % 4 == 0;
+        if (grow) {
+            assert(tree.insert(num) == expected.insert(num).second);
+        } else {
+            assert(tree.remove(num) == (expected.erase(num) == 1));
+        }
+        assert(tree.find(num) == (expected.count(num) == 1));
+        if (round % 2000 == 0) {
+            checkTree(tree, expected);
+            T lo = rand() % 6000, hi = lo + rand() % 500;
+            vector<T> inRange;
+            assert(tree.rangeScan(lo, hi, [&inRange](const T& element) { inRange.push_back(element); }) == inRange.size());
+            assert(inRange == vector<T>(expected.lower_bound(lo), expected.upper_bound(hi)));
+            typename BPlusTree<LINES>::Iterator at = tree.lower_bound(lo);
+            assert(at == tree.end() ? expected.lower_bound(lo) == expected.end() : *at == *expected.lower_bound(lo));
+        }
+    }
+    for (T num : vector<T>(expected.begin(), expected.end())) {
+        assert(tree.remove(num));
+        expected.erase(num);
+    }
+    checkTree(tree, expected);
+
+    //sequential inserts fill leaves from the left, and extreme keys take the SSE2 edge cases
+    for (T num = 0; num < 5000; num++) {
+        tree.insert(num);
+        expected.insert(num);
+    }
+    assert(tree.insert(INT_MAX) && tree.insert(INT_MIN));
+    expected.insert(INT_MAX);
+    expected.insert(INT_MIN);
+    assert(tree.find(INT_MAX) && tree.find(INT_MIN) && !tree.find(INT_MAX - 1));
+    checkTree(tree, expected);
+    tree.clear();
+    expected.clear();
+    checkTree(tree, expected);
+}
+
+int main() {
+    srand(1);
+    testTree<1>();
+    testTree<2>();
+    testTree<4>();
+    cout << "Success" << endl;
+    return 0;
+}
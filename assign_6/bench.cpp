@@ -0,0 +1,397 @@
+/**
+ * Benchmark for heap sort, for the number of children per heap node, and for the priority queues
+ * with decrease-key.
+ * Usage: ./bench [sort] [number of elements]     (default 10^8 elements)
+ *        ./bench dary [number of elements]       (default 10^7 elements)
+ *        ./bench dijkstra [number of vertices]   (default 10^6 vertices)
+ *
+ * sort: sorts the same random array with the in-place heapSort, with the heap sort it replaced
+ * (copy the array into a Heap, then removeMax n times, without the printing), and with
+ * hybridQuickSort from assign_3. Comparisons are counted on a 10^6 element array with a
+ * counting comparison type run through the same sift down code.
+ *
+ * dary: runs the same mixed workloads on Heap and on DaryHeap with 2, 4, 8 and 16 children:
+ * "fill/drain" inserts n random keys then removes them all, "hold" keeps a heapified queue of
+ * n keys and replaces the max with a smaller key n times, the way an event queue is used, and
+ * "mixed" runs n random inserts and removes on a queue that starts with n / 2 keys.
+ *
+ * dijkstra: records the queue operations of Dijkstra's algorithm (with negated distances, as
+ * the heaps are max heaps) on random graphs with 4 and 32 edges per vertex and on a square grid, then
+ * replays each trace on every queue. IndexedHeap, PairingHeap and RadixHeap change keys through
+ * handles. Heap and DaryHeap cannot, so they get a duplicate insert for each changeKey and pop
+ * the stale entries, the way Dijkstra is written without decrease-key.
+ */
+#include "heap.h"
+#include "dary_heap.h"
+#include "indexed_heap.h"
+#include "pairing_heap.h"
+#include "radix_heap.h"
+#include "../assign_3/sorting.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Sort a copy of values with one sort, check the result and print the time
+ * @param name name of the sort
+ * @param values the input
+ * @param sort function sorting a T array of the given length
+ */
+template <typename Sort>
+void runSort(const char* name, const vector<T>& values, Sort sort) {
+    vector<T> copy = values;
+    auto start = chrono::steady_clock::now();
+    sort(copy.data(), (int)copy.size());
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    bool sorted = is_sorted(copy.begin(), copy.end());
+    cout << name << ": " << elapsed.count() << " s (" << elapsed.count() * 1e9 / values.size()
+         << " ns/element)" << (sorted ? "" : " NOT SORTED") << endl;
+}
+
+/**
+ * @brief The heap sort that heapSort replaced: copy into a Heap and take the max n times
+ */
+void copyHeapSort(T values[], int length) {
+    Heap heap = Heap(values, length);
+    for (int i = length - 1; i >= 0; i--) {
+        values[i] = heap.removeMax();
+    }
+}
+
+/**
+ * @brief Count the comparisons of the two sift downs on random arrays of n elements,
+ * each level costing 2 in the standard one and 1 plus the climb in Floyd's
+ */
+void countComparisons(int n) {
+    mt19937 rng(2);
+    vector<T> values(n);
+    for (T& value : values) {
+        value = rng();
+    }
+    long standard = 0, bottomUp = 0;
+    //standard: make a heap, then compare both children of the hole at every level down
+    vector<T> heap = values;
+    make_heap(heap.begin(), heap.end());
+    for (int end = n - 1; end > 0; end--) {
+        T last = heap[end];
+        heap[end] = heap[0];
+        int index = 0;
+        while (true) {
+            int child = 2 * index + 1;
+            if (child >= end) {
+                break;
+            }
+            if (child + 1 < end) {
+                standard++;
+                if (heap[child + 1] > heap[child]) {
+                    child++;
+                }
+            }
+            standard++;
+            if (!(heap[child] > last)) {
+                break;
+            }
+            heap[index] = heap[child];
+            index = child;
+        }
+        heap[index] = last;
+    }
+    //bottom-up: one comparison per level down to a leaf, then one per level climbed back
+    heap = values;
+    make_heap(heap.begin(), heap.end());
+    for (int end = n - 1; end > 0; end--) {
+        T last = heap[end];
+        heap[end] = heap[0];
+        int index = 0;
+        int child = 2;
+        while (child < end) {
+            bottomUp++;
+            if (heap[child - 1] > heap[child]) {
+                child--;
+            }
+            heap[index] = heap[child];
+            index = child;
+            child = 2 * index + 2;
+        }
+        if (child == end) {
+            heap[index] = heap[child - 1];
+            index = child - 1;
+        }
+        while (index > 0) {
+            bottomUp++;
+            int parent = (index - 1) / 2;
+            if (!(heap[parent] < last)) {
+                break;
+            }
+            heap[index] = heap[parent];
+            index = parent;
+        }
+        heap[index] = last;
+    }
+    cout << "comparisons per removed max at " << n << " elements: standard sift down "
+         << (double)standard / (n - 1) << ", bottom-up " << (double)bottomUp / (n - 1) << endl;
+}
+
+/**
+ * @brief Run the three workloads of the dary mode on one kind of heap and print the times
+ * @param name name of the heap
+ * @param n the number of keys
+ * @param keys random keys, at least 2n
+ */
+template <typename Queue>
+void runWorkloads(const char* name, int n, const vector<T>& keys) {
+    long checksum = 0;
+    auto start = chrono::steady_clock::now();
+    {
+        Queue queue(n);
+        for (int i = 0; i < n; i++) {
+            queue.insert(keys[i]);
+        }
+        for (int i = 0; i < n; i++) {
+            checksum += queue.removeMax();
+        }
+    }
+    chrono::duration<double> fill = chrono::steady_clock::now() - start;
+
+    Queue held(const_cast<T*>(keys.data()), n);
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        T max = held.removeMax();
+        checksum += max;
+        held.insert(max - (keys[n + i] & 0xffff));
+    }
+    chrono::duration<double> hold = chrono::steady_clock::now() - start;
+
+    Queue mixed(const_cast<T*>(keys.data()), n / 2);
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        if ((keys[n + i] & 1) || mixed.size() == 0) {
+            mixed.insert(keys[i]);
+        } else {
+            checksum += mixed.removeMax();
+        }
+    }
+    chrono::duration<double> random = chrono::steady_clock::now() - start;
+
+    cout << name << ": fill/drain " << fill.count() * 1e9 / n << " ns/key, hold "
+         << hold.count() * 1e9 / n << " ns/op, mixed " << random.count() * 1e9 / n
+         << " ns/op (checksum " << checksum << ")" << endl;
+}
+
+/**
+ * @brief Compare Heap and DaryHeap with 2, 4, 8 and 16 children on the same keys
+ * @param n the number of keys
+ */
+void sweepChildren(int n) {
+    mt19937 rng(3);
+    vector<T> keys(2 * (size_t)n);
+    for (T& key : keys) {
+        key = rng() >> 1;
+    }
+    cout << n << " keys" << endl;
+    runWorkloads<Heap>("Heap            ", n, keys);
+    runWorkloads<DaryHeap<T, 2> >("DaryHeap<T, 2> ", n, keys);
+    runWorkloads<DaryHeap<T, 4> >("DaryHeap<T, 4> ", n, keys);
+    runWorkloads<DaryHeap<T, 8> >("DaryHeap<T, 8> ", n, keys);
+    runWorkloads<DaryHeap<T, 16> >("DaryHeap<T, 16>", n, keys);
+}
+
+/**
+ * @brief The queue operations of one run of Dijkstra's algorithm
+ */
+struct Trace {
+    enum Op { INSERT, CHANGE_KEY, REMOVE_MAX };
+
+    struct Step {
+        Op op;
+        int vertex;
+        T key; // the key inserted or changed to, or the key removeMax returns
+    };
+
+    const char* name;
+    int vertices;
+    vector<Step> steps;
+};
+
+/**
+ * @brief Run Dijkstra's algorithm from vertex 0 and record its queue operations
+ * @param name name of the graph
+ * @param edges the graph
+ */
+Trace recordTrace(const char* name, const vector<vector<pair<int, int> > >& edges) {
+    Trace trace;
+    trace.name = name;
+    trace.vertices = edges.size();
+    vector<T> distance(edges.size(), -1);
+    vector<IndexedHeap<T>::Handle> handle(edges.size(), -1);
+    IndexedHeap<T> heap;
+    vector<int> vertex;
+    handle[0] = heap.insert(0);
+    vertex.push_back(0);
+    trace.steps.push_back({Trace::INSERT, 0, 0});
+    while (heap.size() > 0) {
+        int u = vertex[heap.getMaxHandle()];
+        T key = heap.removeMax();
+        distance[u] = -key;
+        trace.steps.push_back({Trace::REMOVE_MAX, u, key});
+        for (const pair<int, int>& edge : edges[u]) {
+            int v = edge.first;
+            T through = distance[u] + edge.second;
+            if (handle[v] == -1) {
+                handle[v] = heap.insert(-through);
+                vertex.push_back(v);
+                trace.steps.push_back({Trace::INSERT, v, -through});
+            } else if (distance[v] == -1 && -heap.get(handle[v]) > through) {
+                heap.changeKey(handle[v], -through);
+                trace.steps.push_back({Trace::CHANGE_KEY, v, -through});
+            }
+        }
+    }
+    return trace;
+}
+
+/**
+ * @brief Print the time of one replay
+ */
+void printReplay(const char* name, const Trace& trace, chrono::duration<double> elapsed, bool correct) {
+    cout << "  " << name << ": " << elapsed.count() * 1e3 << " ms (" << elapsed.count() * 1e9 / trace.steps.size()
+         << " ns/op)" << (correct ? "" : " WRONG ORDER") << endl;
+}
+
+/**
+ * @brief Replay a trace on a queue with handles
+ */
+template <typename Queue>
+void replayWithHandles(const char* name, const Trace& trace) {
+    vector<typename Queue::Handle> handle(trace.vertices);
+    bool correct = true;
+    auto start = chrono::steady_clock::now();
+    {
+        Queue queue;
+        for (const Trace::Step& step : trace.steps) {
+            switch (step.op) {
+            case Trace::INSERT:
+                handle[step.vertex] = queue.insert(step.key);
+                break;
+            case Trace::CHANGE_KEY:
+                queue.changeKey(handle[step.vertex], step.key);
+                break;
+            default:
+                correct &= queue.removeMax() == step.key;
+            }
+        }
+    }
+    printReplay(name, trace, chrono::steady_clock::now() - start, correct);
+}
+
+/**
+ * @brief Replay a trace on a queue without handles: changeKey becomes a second insert, and
+ * removeMax pops until it gets the key, skipping the entries that were superseded
+ */
+template <typename Queue>
+void replayWithDuplicates(const char* name, const Trace& trace) {
+    auto start = chrono::steady_clock::now();
+    {
+        Queue queue;
+        for (const Trace::Step& step : trace.steps) {
+            if (step.op == Trace::REMOVE_MAX) {
+                while (queue.removeMax() != step.key) {
+                }
+            } else {
+                queue.insert(step.key);
+            }
+        }
+    }
+    printReplay(name, trace, chrono::steady_clock::now() - start, true);
+}
+
+/**
+ * @brief Record Dijkstra traces on a random graph and a grid and replay them on every queue
+ * @param n the number of vertices
+ */
+void compareQueues(int n) {
+    mt19937 rng(4);
+    vector<vector<pair<int, int> > > random(n), dense(n / 8);
+    for (int u = 0; u < n; u++) {
+        for (int e = 0; e < 4; e++) {
+            random[u].push_back(make_pair((int)(rng() % n), (int)(1 + rng() % 1000)));
+        }
+    }
+    //the same number of edges on an eighth of the vertices, for more changeKeys per vertex
+    for (int u = 0; u < n / 8; u++) {
+        for (int e = 0; e < 32; e++) {
+            dense[u].push_back(make_pair((int)(rng() % (n / 8)), (int)(1 + rng() % 1000)));
+        }
+    }
+    int side = 1;
+    while ((side + 1) * (side + 1) <= n) {
+        side++;
+    }
+    vector<vector<pair<int, int> > > grid(side * side);
+    for (int u = 0; u < side * side; u++) {
+        int row = u / side, column = u % side;
+        if (column + 1 < side) {
+            int weight = 1 + rng() % 100;
+            grid[u].push_back(make_pair(u + 1, weight));
+            grid[u + 1].push_back(make_pair(u, weight));
+        }
+        if (row + 1 < side) {
+            int weight = 1 + rng() % 100;
+            grid[u].push_back(make_pair(u + side, weight));
+            grid[u + side].push_back(make_pair(u, weight));
+        }
+    }
+
+    for (const Trace& trace : {recordTrace("random graph", random), recordTrace("dense random graph", dense),
+                              recordTrace("grid", grid)}) {
+        long counts[3] = {0, 0, 0};
+        for (const Trace::Step& step : trace.steps) {
+            counts[step.op]++;
+        }
+        cout << trace.name << ", " << trace.vertices << " vertices: " << counts[Trace::INSERT] << " inserts, "
+             << counts[Trace::CHANGE_KEY] << " changeKeys, " << counts[Trace::REMOVE_MAX] << " removeMaxes" << endl;
+        replayWithDuplicates<Heap>("Heap, duplicates          ", trace);
+        replayWithDuplicates<DaryHeap<T, 4> >("DaryHeap<T, 4>, duplicates", trace);
+        replayWithHandles<IndexedHeap<T, 2> >("IndexedHeap<T, 2>         ", trace);
+        replayWithHandles<IndexedHeap<T, 4> >("IndexedHeap<T, 4>         ", trace);
+        replayWithHandles<PairingHeap<T> >("PairingHeap<T>            ", trace);
+        replayWithHandles<RadixHeap<T> >("RadixHeap<T>              ", trace);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    string mode = argc > 1 && (argv[1][0] < '0' || argv[1][0] > '9') ? argv[1] : "sort";
+    int argument = mode == "sort" && argc > 1 && argv[1][0] >= '0' && argv[1][0] <= '9' ? 1 : 2;
+    if (mode == "dary") {
+        sweepChildren(argc > argument ? atoi(argv[argument]) : 10000000);
+        return 0;
+    }
+    if (mode == "dijkstra") {
+        compareQueues(argc > argument ? atoi(argv[argument]) : 1000000);
+        return 0;
+    }
+    if (mode != "sort") {
+        cout << "Usage: ./bench [sort|dary|dijkstra] [number of elements]" << endl;
+        return 1;
+    }
+    int n = argc > argument ? atoi(argv[argument]) : 100000000;
+    mt19937 rng(1);
+    vector<T> values(n);
+    for (T& value : values) {
+        value = rng();
+    }
+    cout << n << " elements" << endl;
+    runSort("heapSort, in place, bottom-up", values, heapSort);
+    runSort("Heap copy + removeMax       ", values, copyHeapSort);
+    runSort("hybridQuickSort             ", values, [](T* array, int length) {
+        hybridQuickSort(array, 0, length - 1);
+    });
+    countComparisons(1000000);
+    return 0;
+}
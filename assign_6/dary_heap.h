@@ -0,0 +1,281 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file dary_heap.h
+// @brief This file defines a max heap with D children per node
+//=======================================================
+//
+// In the binary Heap the children of node i are at 2i + 1 and 2i + 2, so a
+// removeMax walks log2 n levels and, once the heap is bigger than the cache,
+// every level is a cache miss that waits for the one before it. DaryHeap gives
+// each node D children, at Di + 1 to Di + D, so the tree is only log_D n levels
+// deep. A level compares D children instead of 2, but the children are adjacent:
+// the array is shifted by D - 1 slots in a 64-byte aligned buffer so that every
+// group of D siblings starts at a multiple of D elements, and when D * sizeof(T)
+// divides 64 a group never crosses a cache line. A removeMax then costs about
+// log_D n misses instead of log_2 n, and an insert, which only compares with
+// parents, gets cheaper too.
+//
+// The whole class is in this header.
+
+#ifndef ASSIGN_6_DARY_HEAP_H
+#define ASSIGN_6_DARY_HEAP_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/**
+ * @brief Implements a max heap with D children per node
+ */
+template <typename Value, int D = 4>
+class DaryHeap
+{
+public:
+    static_assert(D >= 2, "a heap node needs at least two children");
+
+    /**
+     * @brief Default constructor: creates an empty heap
+     * @param capacity the initial capacity of the heap
+     */
+    DaryHeap(int capacity = 100) : heaparray(nullptr), buffer(nullptr), capacity(0), count(0)
+    {
+        reserve(capacity > 0 ? capacity : 1);
+    }
+
+    /**
+     * @brief constructor to build a heap from an array of values
+     * @param values array of values to be added to the heap
+     * @param length the size of the array
+     */
+    DaryHeap(const Value *values, int length) : heaparray(nullptr), buffer(nullptr), capacity(0), count(0)
+    {
+        reserve(length > 0 ? length : 1);
+        for (int i = 0; i < length; i++)
+        {
+            heaparray[i] = values[i];
+        }
+        count = length;
+        heapify();
+    }
+
+    /**
+     * @brief Copy constructor
+     * @param other the heap to be copied
+     */
+    DaryHeap(const DaryHeap &other) : heaparray(nullptr), buffer(nullptr), capacity(0), count(0)
+    {
+        *this = other;
+    }
+
+    /**
+     * @brief Assignment operator
+     * @param other the heap to be copied
+     * @return DaryHeap& a reference to the heap
+     */
+    DaryHeap &operator=(const DaryHeap &other)
+    {
+        if (this != &other)
+        {
+            count = 0;
+            if (capacity < other.count)
+            {
+                reserve(other.count);
+            }
+            for (int i = 0; i < other.count; i++)
+            {
+                heaparray[i] = other.heaparray[i];
+            }
+            count = other.count;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the DaryHeap object
+     */
+    ~DaryHeap()
+    {
+        destroy();
+    }
+
+    /**
+     * @brief reorganizes the array to satisfy the heap property, percolating down every
+     *        internal node from the last one up to the root
+     */
+    void heapify()
+    {
+        for (int i = (count - 2) / D; i >= 0 && count > 1; i--)
+        {
+            percolateDown(i, heaparray[i]);
+        }
+    }
+
+    /**
+     * @brief Inserts a new element into the heap. It maintains the heap property.
+     * @param value the value to be inserted
+     */
+    void insert(Value value)
+    {
+        if (count == capacity)
+        {
+            //a copy of an empty heap has no buffer yet
+            reserve(capacity > 0 ? 2 * capacity : 1);
+        }
+        percolateUp(count++, value);
+    }
+
+    /**
+     * @brief removes the maximum element from the heap, maintaining the heap property.
+     *        The heap must not be empty.
+     * @return the maximum element
+     */
+    Value removeMax()
+    {
+        Value max = heaparray[0];
+        count--;
+        if (count > 0)
+        {
+            percolateDown(0, heaparray[count]);
+        }
+        return max;
+    }
+
+    /**
+     * @brief Change the key of the element at position i to the new value.
+     *        It percolates up or down to maintain the heap property after the change.
+     * @param i the position of the element
+     * @param new_val the new value
+     */
+    void changeKey(int i, Value new_val)
+    {
+        if (new_val < heaparray[i])
+        {
+            percolateDown(i, new_val);
+        }
+        else
+        {
+            percolateUp(i, new_val);
+        }
+    }
+
+    /**
+     * @brief returns the max value in the heap. The heap must not be empty.
+     */
+    const Value &getMax() const { return heaparray[0]; }
+
+    /**
+     * @brief returns the element at position i of the heap array
+     */
+    const Value &at(int i) const { return heaparray[i]; }
+
+    /**
+     * @brief Number of elements in the heap
+     */
+    int size() const { return count; }
+
+    /**
+     * @brief Returns the index of the first child of the node at index
+     */
+    static int firstChild(int index) { return D * index + 1; }
+
+    /**
+     * @brief Returns the index of the parent of the node at index, which must not be the root
+     */
+    static int parent(int index) { return (index - 1) / D; }
+
+private:
+    Value *heaparray; // the heap, D - 1 slots into buffer so sibling groups are aligned
+    void *buffer;     // the 64-byte aligned allocation
+    int capacity;     // the capacity of the heap
+    int count;        // how many elements are in the heap
+
+    /**
+     * @brief Move the heap into a new buffer of the given capacity
+     * @param newCapacity the new capacity, at least count
+     */
+    void reserve(int newCapacity)
+    {
+        void *memory = nullptr;
+        if (posix_memalign(&memory, 64, (newCapacity + D - 1) * sizeof(Value)) != 0)
+        {
+            throw std::bad_alloc();
+        }
+        Value *elements = static_cast<Value *>(memory) + (D - 1);
+        for (int i = 0; i < newCapacity; i++)
+        {
+            new (elements + i) Value(i < count ? heaparray[i] : Value());
+        }
+        destroy();
+        buffer = memory;
+        heaparray = elements;
+        capacity = newCapacity;
+    }
+
+    /**
+     * @brief Destroy the elements and free the buffer
+     */
+    void destroy()
+    {
+        for (int i = 0; i < capacity; i++)
+        {
+            heaparray[i].~Value();
+        }
+        free(buffer);
+        buffer = nullptr;
+        heaparray = nullptr;
+    }
+
+    /**
+     * @brief Put value into the hole at index, moving smaller parents down into the hole
+     * @param index the hole
+     * @param value the value to place
+     */
+    void percolateUp(int index, Value value)
+    {
+        while (index > 0 && heaparray[parent(index)] < value)
+        {
+            heaparray[index] = heaparray[parent(index)];
+            index = parent(index);
+        }
+        heaparray[index] = value;
+    }
+
+    /**
+     * @brief Put value into the hole at index, moving the largest child up into the hole
+     *        while it is larger than value
+     * @param index the hole
+     * @param value the value to place
+     */
+    void percolateDown(int index, Value value)
+    {
+        while (true)
+        {
+            int first = firstChild(index);
+            if (first >= count)
+            {
+                break;
+            }
+            //the siblings share a cache line, so scanning them costs one miss; the
+            //largest so far is picked with selects rather than branches
+            int largest = first;
+            const Value *best = heaparray + first;
+            int last = first + D <= count ? first + D : count;
+            for (int c = first + 1; c < last; c++)
+            {
+                bool larger = *best < heaparray[c];
+                largest = larger ? c : largest;
+                best = larger ? heaparray + c : best;
+            }
+            if (!(value < *best))
+            {
+                break;
+            }
+            heaparray[index] = heaparray[largest];
+            index = largest;
+        }
+        heaparray[index] = value;
+    }
+};
+
+#endif // ASSIGN_6_DARY_HEAP_H
@@ -21,9 +21,12 @@ typedef int T;  // the el_t type is int for now
 void printArray(T values[], int length);
 
 /**
- * @brief Runs a heap sort by creating a heap out of the values in the array, and then
- * extracting those values one-by-one from the heap back into the array in the proper order.
- *
+ * @brief Sorts the array in ascending order in place with heap sort, without copying it
+ * and without printing. The array is made a max heap, then the max is swapped to the end
+ * n - 1 times. Each sift down uses Floyd's bottom-up method, about log n comparisons
+ * instead of 2 log n.
+ * @param values the array to sort
+ * @param length the length of the array
  */
 void heapSort(T values[], int length);
 
@@ -112,6 +115,8 @@ public:
     /**
      * @brief Change the key of the element at position i to the new value.
      *        It should percolate up or down to maintain the heap property after the change.
+     *        Positions change on every insert and removeMax; IndexedHeap (indexed_heap.h)
+     *        changes keys by a handle that does not.
      * @param i the position of the element to be decreased
      * @param value the new value
      */
@@ -0,0 +1,249 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file indexed_heap.h
+// @brief This file defines a max heap whose elements are reached through stable handles
+//=======================================================
+//
+// Heap::changeKey takes an array index, and the element at that index moves on
+// every swap, so a caller cannot keep track of where its element is. Dijkstra
+// style users push the element again with the new key instead and skip the stale
+// copies when they come out. IndexedHeap gives every inserted element a handle
+// that stays valid until the element is removed, and keeps a position map from
+// handle to array index that is updated every time an element moves. changeKey,
+// erase and contains then take a handle and cost O(log n).
+//
+// The heap has D children per node like DaryHeap (dary_heap.h). Each array slot
+// holds the value and its handle, so comparisons never follow the position map.
+// Handles count up from 0 and are not reused, so contains is false for good once
+// an element is removed, and a caller can index its own arrays by handle. The
+// price is that the position map keeps one int per insert since the last clear,
+// not per element in the heap: a long run of inserts and removes needs clear to
+// give the memory back. Handle is 64 bits so the count cannot overflow first.
+//
+// The whole class is in this header.
+
+#ifndef ASSIGN_6_INDEXED_HEAP_H
+#define ASSIGN_6_INDEXED_HEAP_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Implements a max heap with handles to its elements
+ */
+template <typename Value, int D = 4>
+class IndexedHeap
+{
+public:
+    static_assert(D >= 2, "a heap node needs at least two children");
+
+    /**
+     * @brief Identifies an element from insert until it is removed. Handles are the insert
+     *        count since the last clear, and the heap keeps 4 bytes for each of them.
+     */
+    typedef int64_t Handle;
+
+    /**
+     * @brief Default constructor: creates an empty heap
+     * @param capacity the number of elements to make room for
+     */
+    IndexedHeap(int capacity = 100)
+    {
+        heaparray.reserve(capacity);
+        position.reserve(capacity);
+    }
+
+    /**
+     * @brief Inserts a new element into the heap. It maintains the heap property.
+     * @param value the value to be inserted
+     * @return the handle of the new element
+     */
+    Handle insert(const Value &value)
+    {
+        Handle handle = position.size();
+        position.push_back(heaparray.size());
+        heaparray.push_back(Entry{value, handle});
+        percolateUp(heaparray.size() - 1);
+        return handle;
+    }
+
+    /**
+     * @brief removes the maximum element from the heap, maintaining the heap property.
+     *        The heap must not be empty.
+     * @return the maximum element
+     */
+    Value removeMax()
+    {
+        Value max = heaparray[0].value;
+        removeAt(0);
+        return max;
+    }
+
+    /**
+     * @brief Change the key of an element. It percolates up or down to maintain the heap property.
+     * @param handle the element, which must be in the heap
+     * @param new_val the new value
+     */
+    void changeKey(Handle handle, const Value &new_val)
+    {
+        int index = position[handle];
+        bool smaller = new_val < heaparray[index].value;
+        heaparray[index].value = new_val;
+        if (smaller)
+        {
+            percolateDown(index);
+        }
+        else
+        {
+            percolateUp(index);
+        }
+    }
+
+    /**
+     * @brief Remove an element
+     * @param handle the element, which must be in the heap
+     */
+    void erase(Handle handle)
+    {
+        removeAt(position[handle]);
+    }
+
+    /**
+     * @brief Check whether an element is still in the heap
+     * @param handle any handle returned by insert, or any other number
+     * @return true if insert returned handle and the element has not been removed
+     */
+    bool contains(Handle handle) const
+    {
+        return handle >= 0 && handle < (Handle)position.size() && position[handle] != REMOVED;
+    }
+
+    /**
+     * @brief returns the value of an element
+     * @param handle the element, which must be in the heap
+     */
+    const Value &get(Handle handle) const { return heaparray[position[handle]].value; }
+
+    /**
+     * @brief returns the max value in the heap. The heap must not be empty.
+     */
+    const Value &getMax() const { return heaparray[0].value; }
+
+    /**
+     * @brief returns the handle of the max value in the heap. The heap must not be empty.
+     */
+    Handle getMaxHandle() const { return heaparray[0].handle; }
+
+    /**
+     * @brief Number of elements in the heap
+     */
+    int size() const { return heaparray.size(); }
+
+    /**
+     * @brief Remove every element, free the position map and start handing out handles from 0 again
+     */
+    void clear()
+    {
+        heaparray.clear();
+        std::vector<int>().swap(position);
+    }
+
+private:
+    /**
+     * @brief A value and the handle it was inserted with
+     */
+    struct Entry
+    {
+        Value value;
+        Handle handle;
+    };
+
+    static const int REMOVED = -1;
+
+    std::vector<Entry> heaparray; // the heap
+    std::vector<int> position;    // the index in heaparray of every handle, REMOVED once it is gone
+
+    /**
+     * @brief Remove the element at index and fill the hole with the last element
+     */
+    void removeAt(int index)
+    {
+        position[heaparray[index].handle] = REMOVED;
+        int last = heaparray.size() - 1;
+        if (index != last)
+        {
+            bool smaller = heaparray[last].value < heaparray[index].value;
+            heaparray[index] = heaparray[last];
+            heaparray.pop_back();
+            position[heaparray[index].handle] = index;
+            if (smaller)
+            {
+                percolateDown(index);
+            }
+            else
+            {
+                percolateUp(index);
+            }
+        }
+        else
+        {
+            heaparray.pop_back();
+        }
+    }
+
+    /**
+     * @brief Move the element at index up while it is larger than its parent
+     */
+    void percolateUp(int index)
+    {
+        Entry entry = heaparray[index];
+        while (index > 0)
+        {
+            int parent = (index - 1) / D;
+            if (!(heaparray[parent].value < entry.value))
+            {
+                break;
+            }
+            heaparray[index] = heaparray[parent];
+            position[heaparray[index].handle] = index;
+            index = parent;
+        }
+        heaparray[index] = entry;
+        position[entry.handle] = index;
+    }
+
+    /**
+     * @brief Move the element at index down while a child is larger than it
+     */
+    void percolateDown(int index)
+    {
+        Entry entry = heaparray[index];
+        int count = heaparray.size();
+        while (true)
+        {
+            int first = D * index + 1;
+            if (first >= count)
+            {
+                break;
+            }
+            int largest = first;
+            int last = first + D <= count ? first + D : count;
+            for (int c = first + 1; c < last; c++)
+            {
+                largest = heaparray[largest].value < heaparray[c].value ? c : largest;
+            }
+            if (!(entry.value < heaparray[largest].value))
+            {
+                break;
+            }
+            heaparray[index] = heaparray[largest];
+            position[heaparray[index].handle] = index;
+            index = largest;
+        }
+        heaparray[index] = entry;
+        position[entry.handle] = index;
+    }
+};
+
+#endif // ASSIGN_6_INDEXED_HEAP_H
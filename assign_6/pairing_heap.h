@@ -0,0 +1,315 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file pairing_heap.h
+// @brief This file defines a max pairing heap with handles and O(1) meld
+//=======================================================
+//
+// A pairing heap is a tree with any number of children per node, kept as a
+// first child and a list of siblings. insert and meld link two roots, making the
+// smaller one the first child of the larger, so they take O(1). removeMax
+// removes the root and links its children in pairs left to right, then links the
+// pairs right to left into one tree; that is O(log n) amortized. Raising a key
+// cuts the node out of its parent's list and links it with the root, which is
+// o(log n) amortized and in practice close to O(1), so decrease-key heavy work
+// such as Dijkstra (with negated keys in this max heap) does better than in an
+// array heap. Lowering a key removes the node and links it back in, O(log n).
+//
+// PairingHeap has the interface of IndexedHeap (indexed_heap.h): insert returns
+// a Handle, and changeKey, erase and get take one; getMax, getMaxHandle,
+// removeMax and size work the same. Here a Handle is the node itself, so it stays
+// valid when the heap is melded into another one, and must not be used after its
+// element is removed. There is no contains.
+//
+// The whole class is in this header.
+
+#ifndef ASSIGN_6_PAIRING_HEAP_H
+#define ASSIGN_6_PAIRING_HEAP_H
+
+#include <vector>
+
+/**
+ * @brief Implements a max pairing heap with handles to its elements
+ */
+template <typename Value>
+class PairingHeap
+{
+    struct Node;
+
+public:
+    /**
+     * @brief Identifies an element from insert until it is removed
+     */
+    typedef Node *Handle;
+
+    /**
+     * @brief Default constructor: creates an empty heap
+     */
+    PairingHeap() : root(nullptr), count(0) {}
+
+    /**
+     * @brief Destroy the PairingHeap object
+     */
+    ~PairingHeap()
+    {
+        clear();
+    }
+
+    /**
+     * @brief Inserts a new element into the heap
+     * @param value the value to be inserted
+     * @return the handle of the new element
+     */
+    Handle insert(const Value &value)
+    {
+        Node *node = new Node(value);
+        root = root ? link(root, node) : node;
+        count++;
+        return node;
+    }
+
+    /**
+     * @brief Move every element of other into this heap. Handles from other stay valid here.
+     * @param other the heap to empty into this one
+     */
+    void meld(PairingHeap &other)
+    {
+        if (this == &other || other.root == nullptr)
+        {
+            return;
+        }
+        root = root ? link(root, other.root) : other.root;
+        count += other.count;
+        other.root = nullptr;
+        other.count = 0;
+    }
+
+    /**
+     * @brief removes the maximum element from the heap. The heap must not be empty.
+     * @return the maximum element
+     */
+    Value removeMax()
+    {
+        Node *max = root;
+        Value value = max->value;
+        root = mergePairs(max->child);
+        delete max;
+        count--;
+        return value;
+    }
+
+    /**
+     * @brief Change the key of an element
+     * @param handle the element, which must be in the heap
+     * @param new_val the new value
+     */
+    void changeKey(Handle handle, const Value &new_val)
+    {
+        if (new_val < handle->value)
+        {
+            //take the node out with its children merged back in, then link it in alone
+            handle->value = new_val;
+            if (handle == root)
+            {
+                root = mergePairs(handle->child);
+            }
+            else
+            {
+                cut(handle);
+                Node *children = mergePairs(handle->child);
+                if (children)
+                {
+                    root = link(root, children);
+                }
+            }
+            handle->child = nullptr;
+            root = root ? link(root, handle) : handle;
+        }
+        else
+        {
+            handle->value = new_val;
+            if (handle != root)
+            {
+                cut(handle);
+                root = link(root, handle);
+            }
+        }
+    }
+
+    /**
+     * @brief Remove an element
+     * @param handle the element, which must be in the heap
+     */
+    void erase(Handle handle)
+    {
+        if (handle == root)
+        {
+            removeMax();
+            return;
+        }
+        cut(handle);
+        Node *children = mergePairs(handle->child);
+        if (children)
+        {
+            root = link(root, children);
+        }
+        delete handle;
+        count--;
+    }
+
+    /**
+     * @brief returns the value of an element
+     * @param handle the element, which must be in the heap
+     */
+    const Value &get(Handle handle) const { return handle->value; }
+
+    /**
+     * @brief returns the max value in the heap. The heap must not be empty.
+     */
+    const Value &getMax() const { return root->value; }
+
+    /**
+     * @brief returns the handle of the max value in the heap. The heap must not be empty.
+     */
+    Handle getMaxHandle() const { return root; }
+
+    /**
+     * @brief Number of elements in the heap
+     */
+    int size() const { return count; }
+
+    /**
+     * @brief Remove every element
+     */
+    void clear()
+    {
+        //a heap built by increasing inserts is a path of n nodes, so no recursion
+        std::vector<Node *> stack;
+        if (root)
+        {
+            stack.push_back(root);
+        }
+        while (!stack.empty())
+        {
+            Node *node = stack.back();
+            stack.pop_back();
+            for (Node *child = node->child; child; child = child->sibling)
+            {
+                stack.push_back(child);
+            }
+            delete node;
+        }
+        root = nullptr;
+        count = 0;
+    }
+
+private:
+    /**
+     * @brief A node: its value, its first child, its next sibling, and its previous
+     *        sibling or, for a first child, its parent
+     */
+    struct Node
+    {
+        Value value;
+        Node *child;
+        Node *sibling;
+        Node *prev;
+
+        Node(const Value &value) : value(value), child(nullptr), sibling(nullptr), prev(nullptr) {}
+    };
+
+    Node *root;
+    int count;
+
+    PairingHeap(const PairingHeap &);
+    PairingHeap &operator=(const PairingHeap &);
+
+    /**
+     * @brief Link two trees, making the root with the smaller value the first child of the other
+     * @return the root of the linked tree
+     */
+    static Node *link(Node *a, Node *b)
+    {
+        if (a->value < b->value)
+        {
+            Node *temp = a;
+            a = b;
+            b = temp;
+        }
+        b->prev = a;
+        b->sibling = a->child;
+        if (a->child)
+        {
+            a->child->prev = b;
+        }
+        a->child = b;
+        a->sibling = nullptr;
+        a->prev = nullptr;
+        return a;
+    }
+
+    /**
+     * @brief Take a node that is not the root out of its parent's list of children
+     */
+    static void cut(Node *node)
+    {
+        if (node->prev->child == node)
+        {
+            node->prev->child = node->sibling;
+        }
+        else
+        {
+            node->prev->sibling = node->sibling;
+        }
+        if (node->sibling)
+        {
+            node->sibling->prev = node->prev;
+        }
+        node->sibling = nullptr;
+        node->prev = nullptr;
+    }
+
+    /**
+     * @brief Link a list of siblings into one tree: link them in pairs left to right,
+     *        then link the pairs right to left
+     * @param first the first sibling, or nullptr
+     * @return the root of the tree, nullptr for an empty list
+     */
+    static Node *mergePairs(Node *first)
+    {
+        //the first pass keeps the pairs in a list in reverse order, through their sibling links
+        Node *pairs = nullptr;
+        while (first)
+        {
+            Node *a = first;
+            Node *b = a->sibling;
+            if (b == nullptr)
+            {
+                a->sibling = pairs;
+                pairs = a;
+                break;
+            }
+            first = b->sibling;
+            Node *pair = link(a, b);
+            pair->sibling = pairs;
+            pairs = pair;
+        }
+        if (pairs == nullptr)
+        {
+            return nullptr;
+        }
+        Node *result = pairs;
+        pairs = pairs->sibling;
+        result->sibling = nullptr;
+        result->prev = nullptr;
+        while (pairs)
+        {
+            Node *next = pairs->sibling;
+            result = link(result, pairs);
+            pairs = next;
+        }
+        return result;
+    }
+};
+
+#endif // ASSIGN_6_PAIRING_HEAP_H
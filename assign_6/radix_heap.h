@@ -0,0 +1,291 @@
+// =======================================================
+// Your name: Jason Gray
+// Compiler:  g++
+// File type: headher file radix_heap.h
+// @brief This file defines a monotone max radix heap for integer keys, with handles
+//=======================================================
+//
+// In Dijkstra's algorithm the keys that come out of the queue never go back up:
+// with the distances negated for a max heap, every key inserted or raised is at
+// most the key removed last. A radix heap uses that. It remembers the last max
+// removed, last, and keeps every key in the bucket numbered by the highest bit in
+// which it differs from last: bucket 0 holds keys equal to last, bucket b keys
+// that first differ in bit b - 1. There is no sorting inside a bucket. When
+// bucket 0 is empty, removeMax takes the first bucket that is not, makes its
+// largest key the new last and spreads the bucket over the lower buckets. A key
+// only ever moves to a lower bucket, so each key is moved at most once per bit,
+// and insert, changeKey and erase are O(1).
+//
+// RadixHeap has the interface of IndexedHeap (indexed_heap.h): insert returns a
+// Handle, and changeKey, erase, get and contains take one; getMax, getMaxHandle,
+// removeMax and size work the same. Handles count up from 0 and are not reused,
+// so as there the position map keeps 8 bytes per insert since the last clear.
+// Value must be an integer type. Every key inserted or changed to must be no
+// larger than the last max removed; before the first removeMax any key is fine.
+// The heap keeps that bound when it runs empty, so a Dijkstra search that drains
+// the queue down to the last vertex and refills it stays correct.
+//
+// The whole class is in this header.
+
+#ifndef ASSIGN_6_RADIX_HEAP_H
+#define ASSIGN_6_RADIX_HEAP_H
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Implements a monotone max heap of integers with handles to its elements
+ */
+template <typename Value>
+class RadixHeap
+{
+public:
+    static_assert(std::is_integral<Value>::value, "a radix heap needs integer keys");
+
+    /**
+     * @brief Identifies an element from insert until it is removed. Handles are the insert
+     *        count since the last clear, and the heap keeps 8 bytes for each of them.
+     */
+    typedef int64_t Handle;
+
+    /**
+     * @brief Default constructor: creates an empty heap
+     * @param capacity the number of handles to make room for
+     */
+    RadixHeap(int capacity = 100) : last(std::numeric_limits<Value>::max()), count(0)
+    {
+        position.reserve(capacity);
+    }
+
+    /**
+     * @brief Inserts a new element into the heap
+     * @param value the value to be inserted, no larger than the last max removed
+     * @return the handle of the new element
+     */
+    Handle insert(Value value)
+    {
+        Handle handle = position.size();
+        position.push_back(Position());
+        place(value, handle);
+        count++;
+        return handle;
+    }
+
+    /**
+     * @brief removes the maximum element from the heap. The heap must not be empty.
+     * @return the maximum element
+     */
+    Value removeMax()
+    {
+        if (buckets[0].empty())
+        {
+            refill();
+        }
+        Entry max = buckets[0].back();
+        buckets[0].pop_back();
+        position[max.handle].bucket = REMOVED;
+        count--;
+        return max.value;
+    }
+
+    /**
+     * @brief Change the key of an element
+     * @param handle the element, which must be in the heap
+     * @param new_val the new value, no larger than the last max removed
+     */
+    void changeKey(Handle handle, Value new_val)
+    {
+        take(handle);
+        place(new_val, handle);
+    }
+
+    /**
+     * @brief Remove an element
+     * @param handle the element, which must be in the heap
+     */
+    void erase(Handle handle)
+    {
+        take(handle);
+        position[handle].bucket = REMOVED;
+        count--;
+    }
+
+    /**
+     * @brief Check whether an element is still in the heap
+     * @param handle any handle returned by insert, or any other number
+     * @return true if insert returned handle and the element has not been removed
+     */
+    bool contains(Handle handle) const
+    {
+        return handle >= 0 && handle < (Handle)position.size() && position[handle].bucket != REMOVED;
+    }
+
+    /**
+     * @brief returns the value of an element
+     * @param handle the element, which must be in the heap
+     */
+    const Value &get(Handle handle) const
+    {
+        return buckets[position[handle].bucket][position[handle].index].value;
+    }
+
+    /**
+     * @brief returns the max value in the heap. The heap must not be empty.
+     */
+    const Value &getMax() const { return maxEntry().value; }
+
+    /**
+     * @brief returns the handle of the max value in the heap, the one removeMax removes next.
+     *        The heap must not be empty.
+     */
+    Handle getMaxHandle() const { return maxEntry().handle; }
+
+    /**
+     * @brief Number of elements in the heap
+     */
+    int size() const { return count; }
+
+    /**
+     * @brief Remove every element, allow any key again, free the position map and start handing
+     *        out handles from 0
+     */
+    void clear()
+    {
+        for (std::vector<Entry> &bucket : buckets)
+        {
+            bucket.clear();
+        }
+        std::vector<Position>().swap(position);
+        last = std::numeric_limits<Value>::max();
+        count = 0;
+    }
+
+private:
+    typedef typename std::make_unsigned<Value>::type Bits;
+
+    static const int BITS = 8 * sizeof(Value);
+
+    static const int REMOVED = -1;
+
+    /**
+     * @brief A value and the handle it was inserted with
+     */
+    struct Entry
+    {
+        Value value;
+        Handle handle;
+    };
+
+    /**
+     * @brief Where the entry of a handle is
+     */
+    struct Position
+    {
+        int bucket;
+        int index;
+    };
+
+    Value last; // the last max removed, or the largest Value before that; every key is no larger
+    int count;  // how many elements are in the heap
+    std::vector<Entry> buckets[BITS + 1];
+    std::vector<Position> position; // the bucket and index of every handle, bucket REMOVED once it is gone
+
+    /**
+     * @brief Map a key to bits that compare as unsigned integers in the same order
+     */
+    static Bits bits(Value value)
+    {
+        Bits result = (Bits)value;
+        if (std::is_signed<Value>::value)
+        {
+            result ^= (Bits)1 << (BITS - 1);
+        }
+        return result;
+    }
+
+    /**
+     * @brief The bucket of a key: 0 if it equals last, else 1 + the highest bit where it differs
+     */
+    int bucketOf(Value value) const
+    {
+        unsigned long long difference = bits(last) ^ bits(value);
+        return difference == 0 ? 0 : 64 - __builtin_clzll(difference);
+    }
+
+    /**
+     * @brief Add the entry of a handle to the bucket of value
+     */
+    void place(Value value, Handle handle)
+    {
+        int bucket = bucketOf(value);
+        position[handle].bucket = bucket;
+        position[handle].index = buckets[bucket].size();
+        buckets[bucket].push_back(Entry{value, handle});
+    }
+
+    /**
+     * @brief Remove the entry of a handle from its bucket, moving the bucket's last entry into its place
+     */
+    void take(Handle handle)
+    {
+        std::vector<Entry> &bucket = buckets[position[handle].bucket];
+        int index = position[handle].index;
+        bucket[index] = bucket.back();
+        position[bucket[index].handle].index = index;
+        bucket.pop_back();
+    }
+
+    /**
+     * @brief Make the largest key in the first bucket that is not empty the new last,
+     *        and spread that bucket over the lower ones. The heap must not be empty.
+     */
+    void refill()
+    {
+        int b = 1;
+        while (buckets[b].empty())
+        {
+            b++;
+        }
+        std::vector<Entry> moving;
+        moving.swap(buckets[b]);
+        last = moving[0].value;
+        for (const Entry &entry : moving)
+        {
+            last = last < entry.value ? entry.value : last;
+        }
+        for (const Entry &entry : moving)
+        {
+            place(entry.value, entry.handle);
+        }
+        //keep the bucket's memory for the next time it fills
+        moving.clear();
+        buckets[b].swap(moving);
+    }
+
+    /**
+     * @brief The entry with the max value, found without moving anything
+     */
+    const Entry &maxEntry() const
+    {
+        if (!buckets[0].empty())
+        {
+            return buckets[0].back();
+        }
+        int b = 1;
+        while (buckets[b].empty())
+        {
+            b++;
+        }
+        //take the last of equal maxes, which is the one refill leaves at the back of bucket 0
+        const Entry *max = &buckets[b][0];
+        for (const Entry &entry : buckets[b])
+        {
+            max = entry.value < max->value ? max : &entry;
+        }
+        return *max;
+    }
+};
+
+#endif // ASSIGN_6_RADIX_HEAP_H
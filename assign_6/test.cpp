@@ -7,6 +7,17 @@
 
 using namespace std;
 
+/**
+ * @brief Print an array, heap sort it and print it again
+ */
+void printSorted(int values[], int length) {
+    cout << "Array Before Sorting: \n";
+    printArray(values, length);
+    heapSort(values, length);
+    cout << "Array After Sorting: \n";
+    printArray(values, length);
+}
+
 int main(int argc, char* argv[]) {
     Heap* heapPtr = new Heap;
 
@@ -65,15 +76,15 @@ int main(int argc, char* argv[]) {
     cout << endl << "Testing heapsort" << endl;
     int arr1[] = { 1, 6, 8, 2, 7, 11, 4, 9, 13, 5, 12 };
     int n1 = sizeof(arr1) / sizeof(arr1[0]);
-    heapSort(arr1, n1);
+    printSorted(arr1, n1);
     int arr2[] = { 1, 3, 5, 10, 9, 8, 15, 17 };
     int n2 = sizeof(arr2) / sizeof(arr2[0]);
-    heapSort(arr2, n2);
+    printSorted(arr2, n2);
     int arr3[] = { 10, 21, -11, 2, 5, 6, 1, -7, 20, 19, 16 };
     int n3 = sizeof(arr3) / sizeof(arr3[0]);
-    heapSort(arr3, n3);
+    printSorted(arr3, n3);
     int arr4[] = { 2, 3, 12, -13, 22, 8, 3, 4, 7, 20, 1 };
     int n4 = sizeof(arr4) / sizeof(arr4[0]);
-    heapSort(arr4, n4);
+    printSorted(arr4, n4);
     delete heapPtr;
 }
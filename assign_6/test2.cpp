@@ -0,0 +1,59 @@
+/**
+ * This file tests the in-place heap sort against std::sort on random, sorted, reversed and repeated input
+ *
+ */
+#include "heap.h"
+#include <algorithm>
+#include <stdlib.h>
+#include <vector>
+#include "assert.h"
+
+using namespace std;
+
+/**
+ * @brief Heap sort a copy of values and compare it with std::sort
+ */
+void checkSort(vector<T> values) {
+    vector<T> expected = values;
+    sort(expected.begin(), expected.end());
+    heapSort(values.data(), values.size());
+    assert(values == expected);
+}
+
+int main() {
+    srand(1);
+
+    cout << "Test every length up to 200" << endl;
+    for (int n = 0; n <= 200; n++) {
+        vector<T> values;
+        for (int i = 0; i < n; i++) {
+            values.push_back(rand() % 1000 - 500);
+        }
+        checkSort(values);
+        //many repeats
+        for (T& value : values) {
+            value %= 3;
+        }
+        checkSort(values);
+    }
+
+    cout << "Test sorted, reversed and constant input" << endl;
+    vector<T> values;
+    for (int i = 0; i < 100000; i++) {
+        values.push_back(i);
+    }
+    checkSort(values);
+    reverse(values.begin(), values.end());
+    checkSort(values);
+    checkSort(vector<T>(1000, 7));
+
+    cout << "Test a large random array" << endl;
+    values.clear();
+    for (int i = 0; i < 1000000; i++) {
+        values.push_back(rand() - RAND_MAX / 2);
+    }
+    checkSort(values);
+
+    cout << "Success" << endl;
+    return 0;
+}
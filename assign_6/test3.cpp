@@ -0,0 +1,119 @@
+/**
+ * This file tests DaryHeap with 2, 3, 4 and 8 children against std::multiset
+ *
+ */
+#include "dary_heap.h"
+#include <iostream>
+#include <set>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include "assert.h"
+
+using namespace std;
+
+/**
+ * @brief Check that no element is larger than its parent and that the heap holds the elements of expected
+ */
+template <typename Value, int D>
+void checkHeap(const DaryHeap<Value, D> &heap, const multiset<Value> &expected) {
+    assert(heap.size() == (int)expected.size());
+    multiset<Value> elements;
+    for (int i = 0; i < heap.size(); i++) {
+        if (i > 0) {
+            assert(!(heap.at(DaryHeap<Value, D>::parent(i)) < heap.at(i)));
+        }
+        elements.insert(heap.at(i));
+    }
+    assert(elements == expected);
+}
+
+/**
+ * @brief Run random inserts, removeMax and changeKey calls on a heap and a multiset
+ */
+template <int D>
+void checkRandom() {
+    cout << "Test " << D << " children per node" << endl;
+    //when D ints fit a cache line evenly no sibling group crosses a line
+    const uintptr_t groupBytes = D * sizeof(int);
+    DaryHeap<int, D> heap(1);
+    multiset<int> expected;
+    for (int i = 0; i < 40000; i++) {
+        int op = rand() % 8;
+        if (op < 4 || expected.empty()) {
+            int value = rand() % 1000;
+            heap.insert(value);
+            expected.insert(value);
+            uintptr_t group = (uintptr_t)&heap.at(0) + DaryHeap<int, D>::firstChild(rand() % heap.size()) * sizeof(int);
+            assert(64 % groupBytes != 0 || group % groupBytes == 0);
+        } else if (op < 7) {
+            assert(heap.getMax() == *expected.rbegin());
+            assert(heap.removeMax() == *expected.rbegin());
+            expected.erase(prev(expected.end()));
+        } else {
+            int index = rand() % heap.size();
+            int value = rand() % 1000;
+            expected.erase(expected.find(heap.at(index)));
+            expected.insert(value);
+            heap.changeKey(index, value);
+        }
+        if (i % 1000 == 0) {
+            checkHeap(heap, expected);
+        }
+    }
+    checkHeap(heap, expected);
+    DaryHeap<int, D> copy(heap);
+    while (heap.size() > 0) {
+        assert(heap.removeMax() == *expected.rbegin());
+        expected.erase(prev(expected.end()));
+    }
+    heap = copy;
+    assert(heap.size() == copy.size() && heap.getMax() == copy.getMax());
+
+    //a copy of an empty heap can grow
+    DaryHeap<int, D> empty;
+    DaryHeap<int, D> emptyCopy(empty);
+    for (int i = 0; i < 100; i++) {
+        emptyCopy.insert(i);
+    }
+    assert(emptyCopy.size() == 100 && emptyCopy.getMax() == 99);
+    empty = DaryHeap<int, D>(1);
+    empty.insert(7);
+    assert(empty.getMax() == 7);
+
+    //heapify every length up to 100
+    for (int n = 1; n <= 100; n++) {
+        int values[100];
+        expected.clear();
+        for (int i = 0; i < n; i++) {
+            values[i] = rand() % 50;
+            expected.insert(values[i]);
+        }
+        DaryHeap<int, D> built(values, n);
+        checkHeap(built, expected);
+    }
+}
+
+int main() {
+    srand(1);
+    checkRandom<2>();
+    checkRandom<3>();
+    checkRandom<4>();
+    checkRandom<8>();
+
+    cout << "Test string elements" << endl;
+    DaryHeap<string, 4> words(1);
+    multiset<string> expected;
+    const char *list[] = {"pear", "apple", "fig", "plum", "kiwi", "lime", "date", "apple", "quince"};
+    for (const char *word : list) {
+        words.insert(word);
+        expected.insert(word);
+    }
+    checkHeap(words, expected);
+    words.changeKey(0, "banana");
+    assert(words.removeMax() == "plum" && words.removeMax() == "pear");
+    assert(words.size() == 7);
+
+    cout << "Success" << endl;
+    return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * This file tests IndexedHeap against std::map, and runs Dijkstra's algorithm with decrease-key
+ *
+ */
+#include "indexed_heap.h"
+#include <iostream>
+#include <map>
+#include <queue>
+#include <stdlib.h>
+#include <utility>
+#include <vector>
+#include "assert.h"
+
+using namespace std;
+
+typedef IndexedHeap<int>::Handle Handle;
+
+/**
+ * @brief Check that the heap holds the elements of expected under the same handles
+ */
+template <int D>
+void checkHeap(const IndexedHeap<int, D> &heap, const map<Handle, int> &expected, Handle handles) {
+    assert(heap.size() == (int)expected.size());
+    assert(!heap.contains(handles + ((Handle)1 << 32)));
+    for (Handle handle = -1; handle <= handles; handle++) {
+        map<Handle, int>::const_iterator it = expected.find(handle);
+        assert(heap.contains(handle) == (it != expected.end()));
+        if (it != expected.end()) {
+            assert(heap.get(handle) == it->second);
+        }
+    }
+}
+
+/**
+ * @brief Run random inserts, removeMax, changeKey and erase calls on a heap and a map from handle to value
+ */
+template <int D>
+void checkRandom() {
+    cout << "Test " << D << " children per node" << endl;
+    IndexedHeap<int, D> heap(1);
+    map<Handle, int> expected;
+    Handle handles = 0;
+    for (int i = 0; i < 40000; i++) {
+        int op = rand() % 10;
+        if (op < 4 || expected.empty()) {
+            int value = rand() % 1000;
+            Handle handle = heap.insert(value);
+            assert(handle == handles++);
+            expected[handle] = value;
+        } else if (op < 6) {
+            int max = -1;
+            for (const pair<const Handle, int> &element : expected) {
+                max = element.second > max ? element.second : max;
+            }
+            assert(heap.getMax() == max && expected[heap.getMaxHandle()] == max);
+            expected.erase(heap.getMaxHandle());
+            assert(heap.removeMax() == max);
+        } else {
+            //pick a handle that may or may not still be in the heap
+            Handle handle = rand() % handles;
+            if (!heap.contains(handle)) {
+                assert(expected.count(handle) == 0);
+            } else if (op < 8) {
+                int value = rand() % 1000;
+                heap.changeKey(handle, value);
+                expected[handle] = value;
+            } else {
+                heap.erase(handle);
+                expected.erase(handle);
+            }
+        }
+        if (i % 1000 == 0) {
+            checkHeap(heap, expected, handles);
+        }
+    }
+    checkHeap(heap, expected, handles);
+    heap.clear();
+    assert(heap.size() == 0 && !heap.contains(0) && heap.insert(5) == 0);
+}
+
+/**
+ * @brief Dijkstra's algorithm on a random graph with changeKey, checked against a queue with duplicate entries
+ */
+void checkDijkstra() {
+    cout << "Test Dijkstra with changeKey" << endl;
+    const int n = 2000;
+    vector<vector<pair<int, int> > > edges(n);
+    for (int i = 0; i < 5 * n; i++) {
+        edges[rand() % n].push_back(make_pair(rand() % n, 1 + rand() % 100));
+    }
+
+    //the heap is a max heap, so it holds negated distances
+    vector<long> distance(n, -1);
+    vector<Handle> handle(n, -1);
+    IndexedHeap<long> heap;
+    handle[0] = heap.insert(0);
+    vector<int> vertex(1, 0);
+    while (heap.size() > 0) {
+        int u = vertex[heap.getMaxHandle()];
+        distance[u] = -heap.removeMax();
+        for (const pair<int, int> &edge : edges[u]) {
+            int v = edge.first;
+            long through = distance[u] + edge.second;
+            if (handle[v] == -1) {
+                handle[v] = heap.insert(-through);
+                vertex.push_back(v);
+            } else if (heap.contains(handle[v]) && -heap.get(handle[v]) > through) {
+                heap.changeKey(handle[v], -through);
+            }
+        }
+    }
+
+    vector<long> expected(n, -1);
+    priority_queue<pair<long, int>, vector<pair<long, int> >, greater<pair<long, int> > > queue;
+    queue.push(make_pair(0, 0));
+    while (!queue.empty()) {
+        pair<long, int> top = queue.top();
+        queue.pop();
+        if (expected[top.second] != -1) {
+            continue;
+        }
+        expected[top.second] = top.first;
+        for (const pair<int, int> &edge : edges[top.second]) {
+            queue.push(make_pair(top.first + edge.second, edge.first));
+        }
+    }
+    assert(distance == expected);
+}
+
+int main() {
+    srand(1);
+    checkRandom<2>();
+    checkRandom<4>();
+    checkRandom<8>();
+    checkDijkstra();
+
+    cout << "Success" << endl;
+    return 0;
+}
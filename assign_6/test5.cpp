@@ -0,0 +1,196 @@
+/**
+ * This file tests PairingHeap and RadixHeap against std::map, and runs Dijkstra's algorithm on
+ * every priority queue with handles
+ *
+ */
+#include "indexed_heap.h"
+#include "pairing_heap.h"
+#include "radix_heap.h"
+#include <iostream>
+#include <map>
+#include <queue>
+#include <stdlib.h>
+#include <utility>
+#include <vector>
+#include "assert.h"
+
+using namespace std;
+
+/**
+ * @brief Check that the heap holds the values of expected, a map from insert order to handle and value
+ */
+template <typename Queue>
+void checkHeap(const Queue &heap, const map<int, pair<typename Queue::Handle, long> > &expected) {
+    assert(heap.size() == (int)expected.size());
+    long max = 0;
+    for (const auto &element : expected) {
+        assert(heap.get(element.second.first) == element.second.second);
+        max = element.first == expected.begin()->first || element.second.second > max ? element.second.second : max;
+    }
+    if (!expected.empty()) {
+        assert(heap.getMax() == max && heap.get(heap.getMaxHandle()) == max);
+    }
+}
+
+/**
+ * @brief Run random inserts, removeMax, changeKey and erase calls on a heap and a map. With monotone,
+ *        no key is larger than the last max removed, as a RadixHeap needs.
+ */
+template <typename Queue>
+void checkRandom(Queue &heap, bool monotone) {
+    map<int, pair<typename Queue::Handle, long> > expected;
+    long floor = 1L << 40;
+    int inserts = 0;
+    for (int i = 0; i < 40000; i++) {
+        int op = rand() % 10;
+        long value = monotone ? floor - rand() % 1000 : rand() % 1000 - 500;
+        if (op < 4 || expected.empty()) {
+            expected[inserts++] = make_pair(heap.insert(value), value);
+        } else if (op < 6) {
+            map<int, pair<typename Queue::Handle, long> > before = expected;
+            typename Queue::Handle handle = heap.getMaxHandle();
+            long max = heap.getMax();
+            for (typename map<int, pair<typename Queue::Handle, long> >::iterator it = expected.begin(); it != expected.end(); ++it) {
+                if (it->second.first == handle) {
+                    assert(it->second.second == max);
+                    expected.erase(it);
+                    break;
+                }
+            }
+            assert(expected.size() + 1 == before.size());
+            assert(heap.removeMax() == max);
+            floor = max;
+        } else {
+            typename map<int, pair<typename Queue::Handle, long> >::iterator it = expected.begin();
+            advance(it, rand() % expected.size());
+            if (op < 9) {
+                heap.changeKey(it->second.first, value);
+                it->second.second = value;
+            } else {
+                heap.erase(it->second.first);
+                expected.erase(it);
+            }
+        }
+        if (i % 500 == 0) {
+            checkHeap(heap, expected);
+        }
+    }
+    checkHeap(heap, expected);
+    while (heap.size() > 0) {
+        heap.removeMax();
+    }
+}
+
+/**
+ * @brief Dijkstra's algorithm on a random graph with changeKey on negated distances
+ * @param edges the graph
+ * @return the distance from vertex 0 to every vertex, -1 if it cannot be reached
+ */
+template <typename Queue>
+vector<long> dijkstra(const vector<vector<pair<int, int> > > &edges) {
+    int n = edges.size();
+    vector<long> distance(n, -1);
+    vector<typename Queue::Handle> handle(n);
+    vector<bool> queued(n, false);
+    //the handles of the vertices, to find the vertex of the max
+    map<typename Queue::Handle, int> vertex;
+    Queue heap;
+    handle[0] = heap.insert(0);
+    queued[0] = true;
+    vertex[handle[0]] = 0;
+    while (heap.size() > 0) {
+        int u = vertex[heap.getMaxHandle()];
+        distance[u] = -heap.removeMax();
+        for (const pair<int, int> &edge : edges[u]) {
+            int v = edge.first;
+            long through = distance[u] + edge.second;
+            if (!queued[v]) {
+                handle[v] = heap.insert(-through);
+                queued[v] = true;
+                vertex[handle[v]] = v;
+            } else if (distance[v] == -1 && -heap.get(handle[v]) > through) {
+                heap.changeKey(handle[v], -through);
+            }
+        }
+    }
+    return distance;
+}
+
+int main() {
+    srand(1);
+
+    cout << "Test a pairing heap" << endl;
+    PairingHeap<long> pairing;
+    checkRandom(pairing, false);
+    checkRandom(pairing, true);
+
+    cout << "Test melding pairing heaps" << endl;
+    PairingHeap<long> left, right;
+    PairingHeap<long>::Handle moved = right.insert(7);
+    for (int i = 0; i < 1000; i++) {
+        left.insert(rand() % 1000);
+        right.insert(rand() % 1000);
+    }
+    left.meld(right);
+    assert(left.size() == 2001 && right.size() == 0);
+    left.changeKey(moved, 5000);
+    assert(left.getMaxHandle() == moved && left.removeMax() == 5000);
+    long previous = left.removeMax();
+    while (left.size() > 0) {
+        long max = left.removeMax();
+        assert(max <= previous);
+        previous = max;
+    }
+    //increasing inserts make a path, which clear must not recurse down
+    for (int i = 0; i < 1000000; i++) {
+        left.insert(i);
+    }
+    left.clear();
+    assert(left.size() == 0);
+
+    cout << "Test a radix heap" << endl;
+    RadixHeap<long> radix;
+    checkRandom(radix, true);
+    radix.clear();
+    assert(radix.insert(1L << 50) == 0 && radix.removeMax() == 1L << 50);
+    assert(!radix.contains(-1) && !radix.contains(0) && !radix.contains((RadixHeap<long>::Handle)1 << 32));
+    RadixHeap<int> small;
+    RadixHeap<int>::Handle a = small.insert(-5);
+    RadixHeap<int>::Handle b = small.insert(-2000000000);
+    assert(small.contains(a) && small.contains(b) && !small.contains(2));
+    assert(small.removeMax() == -5 && !small.contains(a));
+    small.insert(-6);
+    small.changeKey(b, -5);
+    assert(small.removeMax() == -5 && small.removeMax() == -6 && small.size() == 0);
+    RadixHeap<unsigned char> bytes;
+    bytes.insert(255);
+    bytes.insert(0);
+    bytes.insert(128);
+    assert(bytes.removeMax() == 255 && bytes.removeMax() == 128 && bytes.removeMax() == 0);
+
+    cout << "Test Dijkstra on every priority queue with handles" << endl;
+    const int n = 2000;
+    vector<vector<pair<int, int> > > edges(n);
+    for (int i = 0; i < 5 * n; i++) {
+        edges[rand() % n].push_back(make_pair(rand() % n, 1 + rand() % 100));
+    }
+    vector<long> expected(n, -1);
+    priority_queue<pair<long, int>, vector<pair<long, int> >, greater<pair<long, int> > > queue;
+    queue.push(make_pair(0, 0));
+    while (!queue.empty()) {
+        pair<long, int> top = queue.top();
+        queue.pop();
+        if (expected[top.second] == -1) {
+            expected[top.second] = top.first;
+            for (const pair<int, int> &edge : edges[top.second]) {
+                queue.push(make_pair(top.first + edge.second, edge.first));
+            }
+        }
+    }
+    assert(dijkstra<IndexedHeap<long> >(edges) == expected);
+    assert(dijkstra<PairingHeap<long> >(edges) == expected);
+    assert(dijkstra<RadixHeap<long> >(edges) == expected);
+
+    cout << "Success" << endl;
+    return 0;
+}